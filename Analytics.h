@@ -0,0 +1,197 @@
+#ifndef ANALYTICS_H
+#define ANALYTICS_H
+
+#include <cmath>
+#include <iostream>
+#include <iomanip>
+#include <string>
+
+// WelfordEstimator - Streaming mean and variance in O(1) per sample
+struct WelfordEstimator {
+    long long count;
+    double mean;
+    double m2;
+
+    WelfordEstimator() : count(0), mean(0.0), m2(0.0) {}
+
+    void add(double x) {
+        count++;
+        double delta = x - mean;
+        mean += delta / count;
+        m2 += delta * (x - mean);
+    }
+
+    double variance() const {
+        return count > 1 ? m2 / (count - 1) : 0.0;
+    }
+
+    // Squared coefficient of variation (0 for deterministic, 1 for exponential)
+    double scv() const {
+        return mean > 0.0 ? variance() / (mean * mean) : 0.0;
+    }
+};
+
+// EwmaEstimator - Exponentially weighted moving average, tracks recent behaviour
+struct EwmaEstimator {
+    double alpha;
+    double value;
+    bool primed;
+
+    EwmaEstimator(double weight = 0.02) : alpha(weight), value(0.0), primed(false) {}
+
+    void add(double x) {
+        if (!primed) {
+            value = x;
+            primed = true;
+        } else {
+            value += alpha * (x - value);
+        }
+    }
+};
+
+// LatencyHistogram - Power-of-two buckets of a duration (us unless noted), O(1) per sample
+struct LatencyHistogram {
+    static const int BUCKETS = 32;      // Bucket i holds [2^(i-1), 2^i); bucket 0 is < 1
+    long long buckets[BUCKETS];
+    long long count;
+    long long total;
+    long long maximum;
+
+    LatencyHistogram() : count(0), total(0), maximum(0) {
+        for (int i = 0; i < BUCKETS; i++) buckets[i] = 0;
+    }
+
+    void add(long long micros) {
+        if (micros < 0) micros = 0;
+        int bucket = 0;
+        while (bucket < BUCKETS - 1 && (1LL << bucket) <= micros) bucket++;
+        buckets[bucket]++;
+        count++;
+        total += micros;
+        if (micros > maximum) maximum = micros;
+    }
+
+    // Upper bound of the bucket holding the given percentile
+    long long percentile(double p) const {
+        if (count == 0) return 0;
+        long long rank = (long long)std::ceil(p / 100.0 * count);
+        long long seen = 0;
+        for (int i = 0; i < BUCKETS; i++) {
+            seen += buckets[i];
+            if (seen >= rank) return std::min(maximum, 1LL << i);
+        }
+        return maximum;
+    }
+
+    double mean() const { return count > 0 ? (double)total / count : 0.0; }
+
+    void display(std::ostream& out, const std::string& label, const std::string& unit = "us") const {
+        out << "  " << label << ": " << count << " samples";
+        if (count == 0) {
+            out << "\n";
+            return;
+        }
+        out << ", mean " << mean() << " " << unit << ", p50 <= " << percentile(50)
+            << " " << unit << ", p99 <= " << percentile(99) << " " << unit
+            << ", max " << maximum << " " << unit << "\n";
+        for (int i = 0; i < BUCKETS; i++) {
+            if (buckets[i] == 0) continue;
+            out << "    < " << std::setw(8) << (1LL << i) << " " << unit << ": " << buckets[i] << "\n";
+        }
+    }
+};
+
+/**
+ * QueueAnalytics - Online queueing statistics for one scheduler.
+ *
+ * Updated once per cycle and once per completed process, never by scanning
+ * history. Rates are per cycle; the system is the ready queue plus the cores.
+ * The prediction treats the scheduler as an M/G/c queue (Poisson arrivals,
+ * general service, c cores) using Erlang C with the Allen-Cunneen correction.
+ */
+class QueueAnalytics {
+private:
+    WelfordEstimator arrivalsPerCycle;
+    EwmaEstimator recentArrivals;
+    WelfordEstimator serviceCycles;     // Total CPU cycles per finished process
+    WelfordEstimator inSystem;          // Ready + running, sampled every cycle
+    WelfordEstimator readyLength;
+    WelfordEstimator busyFraction;
+    int cores;
+
+public:
+    QueueAnalytics() : cores(1) {}
+
+    void recordCycle(int arrivals, int ready, int running, int coreCount) {
+        arrivalsPerCycle.add(arrivals);
+        recentArrivals.add(arrivals);
+        inSystem.add(ready + running);
+        readyLength.add(ready);
+        busyFraction.add(coreCount > 0 ? (double)running / coreCount : 0.0);
+        cores = coreCount;
+    }
+
+    void recordCompletion(int cpuCycles) {
+        serviceCycles.add(cpuCycles);
+    }
+
+    double getArrivalRate() const { return arrivalsPerCycle.mean; }
+    double getRecentArrivalRate() const { return recentArrivals.value; }
+    double getServiceRate() const { return serviceCycles.mean > 0.0 ? 1.0 / serviceCycles.mean : 0.0; }
+    double getMeanInSystem() const { return inSystem.mean; }
+    double getMeanReadyLength() const { return readyLength.mean; }
+    double getMeasuredUtilization() const { return busyFraction.mean; }
+
+    // Offered load per core, rho = lambda / (c * mu)
+    double getOfferedUtilization() const {
+        double mu = getServiceRate();
+        return (mu > 0.0 && cores > 0) ? getArrivalRate() / (cores * mu) : 0.0;
+    }
+
+    // Probability an arrival has to wait in an M/M/c queue (Erlang C)
+    static double erlangC(int c, double offeredLoad) {
+        double rho = offeredLoad / c;
+        if (rho >= 1.0) return 1.0;
+        double erlangB = 1.0;
+        for (int k = 1; k <= c; k++) {
+            erlangB = offeredLoad * erlangB / (k + offeredLoad * erlangB);
+        }
+        return erlangB / (1.0 - rho * (1.0 - erlangB));
+    }
+
+    void display(std::ostream& out) const {
+        double lambda = getArrivalRate();
+        double mu = getServiceRate();
+        double rho = getOfferedUtilization();
+        
+        out << "Queueing analytics (per cycle):\n";
+        out << "  Arrival rate (lambda): " << lambda << "  (recent " << getRecentArrivalRate() << ")\n";
+        out << "  Service rate per core (mu): " << mu;
+        if (serviceCycles.count > 0) {
+            out << "  (mean " << serviceCycles.mean << " cycles, SCV " << serviceCycles.scv() << ")";
+        }
+        out << "\n";
+        out << "  Utilization: measured " << getMeasuredUtilization() * 100.0
+            << "%, offered " << rho * 100.0 << "%\n";
+        out << "  Mean in system (L): " << getMeanInSystem()
+            << "  Mean ready queue (Lq): " << getMeanReadyLength() << "\n";
+        if (lambda > 0.0) {
+            out << "  Little's law: W = L / lambda = " << getMeanInSystem() / lambda << " cycles\n";
+        }
+        
+        if (mu <= 0.0 || lambda <= 0.0) {
+            out << "  M/G/" << cores << " prediction: (waiting for arrivals and completions)\n";
+        } else if (rho >= 1.0) {
+            out << "  M/G/" << cores << " prediction: SATURATED (rho >= 1), queue grows without bound\n";
+        } else {
+            double offeredLoad = lambda / mu;
+            double waitMMc = erlangC(cores, offeredLoad) / (cores * mu - lambda);
+            double wq = waitMMc * (1.0 + serviceCycles.scv()) / 2.0;
+            double lq = lambda * wq;
+            out << "  M/G/" << cores << " prediction: Wq " << wq << " cycles, Lq " << lq
+                << ", L " << lq + offeredLoad << "\n";
+        }
+    }
+};
+
+#endif // ANALYTICS_H
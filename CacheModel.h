@@ -0,0 +1,148 @@
+#ifndef CACHEMODEL_H
+#define CACHEMODEL_H
+
+#include <algorithm>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// CacheLevel - One set-associative cache level, tags only (no data)
+// Tags of a set are contiguous, so a lookup scans one short run of memory.
+class CacheLevel {
+private:
+    static constexpr uint64_t INVALID = ~0ULL;
+
+    int sets;
+    int ways;
+    int lineShift;
+    bool pseudoLRU;
+    std::vector<uint64_t> tags;      // sets * ways line numbers
+    std::vector<uint8_t> ages;       // LRU: rank per way, 0 = most recent
+    std::vector<uint16_t> treeBits;  // PLRU: one binary tree per set (ways <= 16)
+    long long hits;
+    long long misses;
+
+    // Mark a way as most recently used
+    void touch(int set, int way) {
+        if (pseudoLRU) {
+            // Point every node on the path away from this way
+            uint16_t& bits = treeBits[set];
+            int node = 1;
+            for (int span = ways / 2; span >= 1; span /= 2) {
+                int right = (way & span) ? 1 : 0;
+                if (right) bits &= ~(1 << node);
+                else bits |= (1 << node);
+                node = node * 2 + right;
+            }
+            return;
+        }
+        uint8_t* rank = &ages[set * ways];
+        uint8_t old = rank[way];
+        for (int w = 0; w < ways; w++) {
+            if (rank[w] < old) rank[w]++;
+        }
+        rank[way] = 0;
+    }
+
+    int victim(int set) const {
+        const uint64_t* setTags = &tags[set * ways];
+        for (int w = 0; w < ways; w++) {
+            if (setTags[w] == INVALID) return w;
+        }
+        if (pseudoLRU) {
+            uint16_t bits = treeBits[set];
+            int node = 1, way = 0;
+            for (int span = ways / 2; span >= 1; span /= 2) {
+                int right = (bits >> node) & 1;
+                way |= right ? span : 0;
+                node = node * 2 + right;
+            }
+            return way;
+        }
+        const uint8_t* rank = &ages[set * ways];
+        int oldest = 0;
+        for (int w = 1; w < ways; w++) {
+            if (rank[w] > rank[oldest]) oldest = w;
+        }
+        return oldest;
+    }
+
+public:
+    CacheLevel() : sets(1), ways(1), lineShift(6), pseudoLRU(false), hits(0), misses(0) {}
+
+    // sets and lineSize must be powers of two; PLRU also needs power-of-two ways
+    void configure(int setCount, int wayCount, int lineSize, bool plru) {
+        sets = setCount;
+        ways = wayCount;
+        pseudoLRU = plru;
+        lineShift = 0;
+        while ((1 << lineShift) < lineSize) lineShift++;
+        tags.assign(sets * ways, INVALID);
+        ages.resize(sets * ways);
+        treeBits.assign(sets, 0);
+        invalidate();
+        hits = 0;
+        misses = 0;
+    }
+
+    // Look up one address, filling the line on a miss. Returns true on a hit.
+    bool access(uint64_t address) {
+        uint64_t line = address >> lineShift;
+        int set = (int)(line & (sets - 1));
+        uint64_t* setTags = &tags[set * ways];
+        for (int w = 0; w < ways; w++) {
+            if (setTags[w] == line) {
+                touch(set, w);
+                hits++;
+                return true;
+            }
+        }
+        int w = victim(set);
+        setTags[w] = line;
+        touch(set, w);
+        misses++;
+        return false;
+    }
+
+    void invalidate() {
+        std::fill(tags.begin(), tags.end(), INVALID);
+        for (int i = 0; i < (int)ages.size(); i++) ages[i] = (uint8_t)(i % ways);
+        std::fill(treeBits.begin(), treeBits.end(), 0);
+    }
+
+    int getLineSize() const { return 1 << lineShift; }
+    long long getHits() const { return hits; }
+    long long getMisses() const { return misses; }
+    long long getAccesses() const { return hits + misses; }
+};
+
+// CacheHierarchy - Private L1 backed by a private L2, both non-inclusive
+struct CacheHierarchy {
+    CacheLevel l1;
+    CacheLevel l2;
+    int l2Latency;          // Extra cycles when L1 misses and L2 hits
+    int memoryLatency;      // Extra cycles when both miss
+
+    CacheHierarchy() : l2Latency(0), memoryLatency(0) {}
+
+    // Touch every line of [address, address + bytes). Returns the stall in cycles.
+    int access(uint64_t address, int bytes) {
+        int stall = 0;
+        int lineSize = l1.getLineSize();
+        uint64_t first = address & ~(uint64_t)(lineSize - 1);
+        for (uint64_t a = first; a < address + (uint64_t)bytes; a += lineSize) {
+            if (l1.access(a)) continue;
+            stall += l2.access(a) ? l2Latency : memoryLatency;
+        }
+        return stall;
+    }
+
+    // "all" empties both levels, "l1" only the first, "none" keeps everything
+    void flush(const std::string& policy) {
+        if (policy == "none") return;
+        l1.invalidate();
+        if (policy == "all") l2.invalidate();
+    }
+};
+
+#endif // CACHEMODEL_H
@@ -0,0 +1,420 @@
+#ifndef CLUSTER_H
+#define CLUSTER_H
+
+#include <vector>
+#include <deque>
+#include <string>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+#include <atomic>
+#include <random>
+#include <chrono>
+#include <ctime>
+#include <iostream>
+#include "Scheduler.h"
+
+// EpochBarrier - Reusable barrier; the last thread to arrive runs the
+// epoch function before anyone is released
+class EpochBarrier {
+private:
+    std::mutex barrierMutex;
+    std::condition_variable released;
+    int parties;
+    int waiting;
+    long long generation;
+    std::function<void()> onEpoch;
+    
+    // Host time lost to synchronization, summed over threads
+    std::atomic<long long> waitNanos;     // Blocked for slower threads and the epoch function
+    std::atomic<long long> epochNanos;    // Spent in the epoch function (serial section)
+
+public:
+    EpochBarrier(int count, std::function<void()> epochFn)
+        : parties(count), waiting(0), generation(0), onEpoch(epochFn), waitNanos(0), epochNanos(0) {}
+
+    void arriveAndWait() {
+        auto arrived = std::chrono::steady_clock::now();
+        std::unique_lock<std::mutex> lock(barrierMutex);
+        long long arrivedIn = generation;
+        if (++waiting == parties) {
+            auto epochStart = std::chrono::steady_clock::now();
+            onEpoch();
+            epochNanos += std::chrono::duration_cast<std::chrono::nanoseconds>(
+                std::chrono::steady_clock::now() - epochStart).count();
+            waiting = 0;
+            generation++;
+            released.notify_all();
+        } else {
+            released.wait(lock, [&]() { return generation != arrivedIn; });
+        }
+        waitNanos += std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now() - arrived).count();
+    }
+
+    long long getWaitNanos() const { return waitNanos; }
+    long long getEpochNanos() const { return epochNanos; }
+};
+
+/**
+ * Cluster - Several Scheduler nodes, each with its own cores and
+ * MemoryManager, fed by one dispatcher.
+ *
+ * Every node runs on its own host thread and advances clusterEpochCycles
+ * cycles on its own. Nodes only meet at epoch boundaries, where the
+ * dispatcher generates arrivals, picks a node for each, starts migrations
+ * and delivers anything whose network delay has elapsed. Delivery therefore
+ * happens at epoch granularity: keep network-delay a multiple of the epoch
+ * for exact timing.
+ *
+ * Each node has max-overall-mem bytes of its own. A node given no
+ * MemoryManager serves them from the slab backend when process sizes are
+ * discrete (mem-size-classes, or a fixed mem-per-proc), so with the default
+ * 16 KiB and 4 KiB per process it holds 4 processes at a time. With a size
+ * range and no classes it has no backend: only committed memory is tracked,
+ * and only memory-fit dispatch keeps it within max-overall-mem.
+ */
+class Cluster {
+public:
+    enum DispatchPolicy {
+        ROUND_ROBIN,
+        LEAST_LOADED,
+        POWER_OF_TWO,   // Sample two nodes, pick the less loaded one
+        MEMORY_FIT      // Fullest node the process still fits on (best fit)
+    };
+
+    static bool parsePolicy(const std::string& name, DispatchPolicy& policy) {
+        if (name == "rr" || name == "round-robin") policy = ROUND_ROBIN;
+        else if (name == "least-loaded") policy = LEAST_LOADED;
+        else if (name == "p2c" || name == "power-of-two") policy = POWER_OF_TWO;
+        else if (name == "memory-fit") policy = MEMORY_FIT;
+        else return false;
+        return true;
+    }
+
+    static std::string policyName(DispatchPolicy policy) {
+        switch (policy) {
+            case ROUND_ROBIN: return "round-robin";
+            case LEAST_LOADED: return "least-loaded";
+            case POWER_OF_TWO: return "power-of-two";
+            case MEMORY_FIT: return "memory-fit";
+            default: return "unknown";
+        }
+    }
+
+private:
+    // A process travelling to a node (new arrival or migration)
+    struct InFlight {
+        Process* process;
+        int node;
+        int deliverCycle;
+    };
+
+    SystemConfig config;
+    DispatchPolicy policy;
+    int tickMs;                         // Real time per cycle (0 = as fast as possible)
+    
+    std::vector<Scheduler*> nodes;
+    std::vector<std::thread> nodeThreads;
+    EpochBarrier barrier;
+    
+    // Dispatcher state, only touched by the epoch function or under stateMutex
+    std::mutex stateMutex;
+    std::deque<InFlight> inFlight;
+    std::vector<int> pendingPerNode;    // In-flight processes headed to each node
+    std::vector<long long> pendingMemory;   // Their memory requests
+    std::vector<int> dispatchedPerNode;
+    std::mt19937 rng;
+    int clusterCycle;
+    int epochs;
+    int nextProcessID;
+    int roundRobinNext;
+    int arrivals;
+    int migrations;
+    int deferredDeliveries;             // Deliveries retried because a node was full
+    
+    std::atomic<bool> stopRequested;
+    bool halted;                        // Copied from stopRequested at each epoch
+    bool generating;
+
+public:
+    // One Scheduler per node, each with config.numCPUs cores. memoryManagers
+    // may be shorter than nodeCount (missing entries mean no MemoryManager,
+    // see above for the backend those nodes get); they stay owned by the caller.
+    Cluster(const SystemConfig& cfg, int nodeCount, DispatchPolicy dispatchPolicy,
+            const std::vector<MemoryManager*>& memoryManagers = std::vector<MemoryManager*>(),
+            int cycleMs = 100)
+        : config(cfg),
+          policy(dispatchPolicy),
+          tickMs(cycleMs),
+          barrier(nodeCount, [this]() { runEpoch(); }),
+          pendingPerNode(nodeCount, 0),
+          pendingMemory(nodeCount, 0),
+          dispatchedPerNode(nodeCount, 0),
+          rng((unsigned int)rand()),
+          clusterCycle(0),
+          epochs(0),
+          nextProcessID(0),
+          roundRobinNext(0),
+          arrivals(0),
+          migrations(0),
+          deferredDeliveries(0),
+          stopRequested(false),
+          halted(false),
+          generating(true) {
+        for (int i = 0; i < nodeCount; i++) {
+            MemoryManager* mm = i < (int)memoryManagers.size() ? memoryManagers[i] : nullptr;
+            
+            // Spell out the slab backend a node without a MemoryManager gets
+            SystemConfig nodeConfig = config;
+            if (!mm && nodeConfig.memSizeClasses.empty() &&
+                nodeConfig.minMemPerProc == nodeConfig.maxMemPerProc && nodeConfig.minMemPerProc > 0) {
+                nodeConfig.memSizeClasses.push_back((int)nodeConfig.minMemPerProc);
+            }
+            nodes.push_back(new Scheduler(nodeConfig, mm));
+            
+            // Nodes share the logs directory: keep their process names apart
+            nodes.back()->setProcessNamePrefix("Node" + std::to_string(i) + "_Process_");
+        }
+    }
+
+    ~Cluster() {
+        stop();
+        for (auto& f : inFlight) delete f.process;
+        for (auto node : nodes) delete node;
+    }
+
+    // Start one host thread per node
+    void start() {
+        if (!nodeThreads.empty()) return;
+        for (int i = 0; i < (int)nodes.size(); i++) {
+            nodeThreads.emplace_back(&Cluster::nodeLoop, this, i);
+        }
+    }
+
+    // Stop at the next epoch boundary and join the node threads
+    void stop() {
+        stopRequested = true;
+        for (auto& t : nodeThreads) {
+            if (t.joinable()) t.join();
+        }
+        nodeThreads.clear();
+    }
+
+    // Turn the cluster-wide arrival generator on or off
+    void setGenerating(bool enabled) {
+        std::lock_guard<std::mutex> lock(stateMutex);
+        generating = enabled;
+    }
+
+    int getNodeCount() const { return (int)nodes.size(); }
+    int getClusterCycle() {
+        std::lock_guard<std::mutex> lock(stateMutex);
+        return clusterCycle;
+    }
+    const EpochBarrier& getBarrier() const { return barrier; }
+    Scheduler* getNode(int index) const { return nodes[index]; }
+
+    // Queue a process for dispatch as if it had just arrived
+    void submit(Process* p) {
+        std::lock_guard<std::mutex> lock(stateMutex);
+        dispatch(p);
+    }
+
+    // Processes still travelling to a node
+    int getInFlightCount() {
+        std::lock_guard<std::mutex> lock(stateMutex);
+        return (int)inFlight.size();
+    }
+
+    // Display per-node load and dispatcher counters
+    void displayReport(std::ostream& out) {
+        std::lock_guard<std::mutex> lock(stateMutex);
+        
+        out << "\n========== CLUSTER REPORT ==========\n";
+        out << "Policy: " << policyName(policy) << "\n";
+        out << "Nodes: " << nodes.size() << " x " << config.numCPUs << " cores, "
+            << config.maxOverallMem << " B memory (backend: " << nodes[0]->getMemoryBackendName() << ")\n";
+        out << "Cluster Cycle: " << clusterCycle << " (" << epochs << " epochs of "
+            << config.clusterEpochCycles << " cycles)\n";
+        out << "Network Delay: " << config.networkDelay << " cycles\n";
+        out << "Arrivals: " << arrivals << "  Migrations: " << migrations
+            << "  In Flight: " << inFlight.size()
+            << "  Deferred Deliveries: " << deferredDeliveries << "\n\n";
+        
+        for (int i = 0; i < (int)nodes.size(); i++) {
+            Scheduler* node = nodes[i];
+            out << "Node " << i << ": dispatched " << dispatchedPerNode[i]
+                << " | ready " << node->getReadyQueueSize()
+                << " | running " << node->getRunningCount()
+                << " | finished " << node->getFinishedCount()
+                << " | migrated out " << node->getMigratedOut()
+                << " | memory " << node->getCommittedMemory()
+                << " | CPU " << node->getCPUUtilization() << "%\n";
+        }
+        out << "====================================\n\n";
+    }
+
+private:
+    // Host thread for one node: run an epoch of cycles, then meet the others
+    void nodeLoop(int index) {
+        Scheduler* node = nodes[index];
+        auto deadline = std::chrono::steady_clock::now();
+        
+        while (true) {
+            for (int c = 0; c < config.clusterEpochCycles; c++) {
+                node->stepCycle();
+                if (tickMs > 0) {
+                    deadline += std::chrono::milliseconds(tickMs);
+                    std::this_thread::sleep_until(deadline);
+                }
+            }
+            
+            barrier.arriveAndWait();
+            if (halted) break;
+        }
+    }
+
+    // Runs on the last node thread to reach the barrier, while all nodes wait
+    void runEpoch() {
+        std::lock_guard<std::mutex> lock(stateMutex);
+        
+        int epochStart = clusterCycle;
+        clusterCycle += config.clusterEpochCycles;
+        epochs++;
+        halted = stopRequested;
+        if (halted) return;
+        
+        // Arrivals: one every batchProcessFreq cycles, cluster-wide
+        if (generating) {
+            int freq = std::max(1, config.batchProcessFreq);
+            for (int cycle = epochStart + 1; cycle <= clusterCycle; cycle++) {
+                if (cycle % freq != 0) continue;
+                // Pick the node before building the process so it is named after it
+                size_t memory = nodes[0]->drawMemorySize(rng);
+                int target = chooseNode((long long)memory);
+                Process* p = nodes[target]->createGeneratedProcess(nextProcessID++, memory, rng);
+                arrivals++;
+                dispatchTo(p, target, cycle);
+            }
+        }
+        
+        // Migration: move one ready process from the busiest to the idlest node
+        if (config.migrationThreshold > 0 && nodes.size() > 1) {
+            int busiest = 0, idlest = 0;
+            for (int i = 1; i < (int)nodes.size(); i++) {
+                if (nodeLoad(i) > nodeLoad(busiest)) busiest = i;
+                if (nodeLoad(i) < nodeLoad(idlest)) idlest = i;
+            }
+            if (nodeLoad(busiest) - nodeLoad(idlest) > config.migrationThreshold) {
+                Process* p = nodes[busiest]->takeMigrationCandidate();
+                if (p) {
+                    migrations++;
+                    send(p, idlest, clusterCycle);
+                }
+            }
+        }
+        
+        deliverArrived();
+    }
+
+    // Hand processes whose delay has elapsed to their node, in send order
+    void deliverArrived() {
+        std::string now = currentTimeString();
+        std::deque<InFlight> stillTravelling;
+        
+        for (auto& f : inFlight) {
+            if (f.deliverCycle > clusterCycle) {
+                stillTravelling.push_back(f);
+                continue;
+            }
+            if (f.process->getArrivalTime().empty()) {
+                f.process->setArrivalTime(now);
+            }
+            if (nodes[f.node]->admitProcess(f.process)) {
+                pendingPerNode[f.node]--;
+                pendingMemory[f.node] -= (long long)f.process->getMemoryRequired();
+            } else {
+                // Node out of memory: retry at the next epoch
+                deferredDeliveries++;
+                stillTravelling.push_back(f);
+            }
+        }
+        inFlight.swap(stillTravelling);
+    }
+
+    // Pick a node for a new process and send it (caller holds stateMutex)
+    void dispatch(Process* p, int sentCycle = -1) {
+        dispatchTo(p, chooseNode((long long)p->getMemoryRequired()), sentCycle);
+    }
+
+    void dispatchTo(Process* p, int target, int sentCycle) {
+        dispatchedPerNode[target]++;
+        send(p, target, sentCycle < 0 ? clusterCycle : sentCycle);
+    }
+
+    void send(Process* p, int node, int sentCycle) {
+        pendingPerNode[node]++;
+        pendingMemory[node] += (long long)p->getMemoryRequired();
+        inFlight.push_back({p, node, sentCycle + config.networkDelay});
+    }
+
+    // Queued + running + still travelling there
+    int nodeLoad(int index) const {
+        return nodes[index]->getLoad() + pendingPerNode[index];
+    }
+
+    // Committed + still travelling there
+    long long nodeMemory(int index) const {
+        return nodes[index]->getCommittedMemory() + pendingMemory[index];
+    }
+
+    // Node for a new process needing 'need' bytes (caller holds stateMutex)
+    int chooseNode(long long need) {
+        int count = (int)nodes.size();
+        switch (policy) {
+            case ROUND_ROBIN: {
+                int target = roundRobinNext;
+                roundRobinNext = (roundRobinNext + 1) % count;
+                return target;
+            }
+            case LEAST_LOADED: {
+                int best = 0;
+                for (int i = 1; i < count; i++) {
+                    if (nodeLoad(i) < nodeLoad(best)) best = i;
+                }
+                return best;
+            }
+            case POWER_OF_TWO: {
+                if (count == 1) return 0;
+                std::uniform_int_distribution<int> pick(0, count - 1);
+                int a = pick(rng);
+                int b = pick(rng);
+                while (b == a) b = pick(rng);
+                return nodeLoad(a) <= nodeLoad(b) ? a : b;
+            }
+            case MEMORY_FIT:
+            default: {
+                // Best fit leaves the emptier nodes free for large processes;
+                // if it fits nowhere, the least committed node frees up first
+                long long capacity = (long long)config.maxOverallMem;
+                int best = -1;
+                int emptiest = 0;
+                for (int i = 0; i < count; i++) {
+                    if (nodeMemory(i) < nodeMemory(emptiest)) emptiest = i;
+                    if (nodeMemory(i) + need > capacity) continue;
+                    if (best < 0 || nodeMemory(i) > nodeMemory(best)) best = i;
+                }
+                return best >= 0 ? best : emptiest;
+            }
+        }
+    }
+
+    std::string currentTimeString() const {
+        auto now = std::chrono::system_clock::now();
+        return ctimeString(std::chrono::system_clock::to_time_t(now));
+    }
+};
+
+#endif // CLUSTER_H
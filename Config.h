@@ -5,18 +5,75 @@
 #include <fstream>
 #include <sstream>
 #include <iostream>
+#include <vector>
 
 // Configuration structure for the OS Simulator
 struct SystemConfig {
     // CPU Configuration
     int numCPUs;
     
+    // SMT: consecutive logical cores share a physical core
+    int smtThreads;             // Hardware threads per physical core (1, 2 or 4)
+    double smtContention;       // Throughput lost per extra busy sibling (0-1)
+    std::string smtPlacement;   // "spread" across physical cores first, or "pack"
+    
+    // Idle states: C(i+1) is entered after cstateThresholds[i] idle cycles
+    // and costs cstateExitLatencies[i] cycles to leave (empty = no C-states)
+    std::vector<int> cstateThresholds;
+    std::vector<int> cstateExitLatencies;
+    bool cstatePreferShallow;   // Dispatch to the shallowest idle core first
+    
+    // Real-time clock
+    int cycleMs;                // Wall time per CPU cycle
+    std::string tickPolicy;     // On overrun: "skip", "burst" or "slow"
+    
+    // Sampling profiler (profile-dump)
+    int profileInterval;        // Cycles between samples of every core (0 = off)
+    
+    // Autoscaling (adds/removes cores at runtime)
+    bool autoscale;
+    int autoscaleTargetWait;    // Ready-queue wait p99 target, in cycles
+    int autoscaleMinCPUs;
+    int autoscaleMaxCPUs;
+    int autoscaleInterval;      // Cycles between scaling decisions
+    
     // Scheduler Configuration
-    std::string schedulerType;  // "fcfs" or "rr"
+    std::string schedulerType;  // "fcfs", "rr" or "backfill" (EASY)
     int quantumCycles;          // For Round Robin
+    std::string dagPriority;    // "fifo" or "critical-path" ready ordering
     int batchProcessFreq;       // How often to generate processes
+    int prefetchPoolSize;       // Ready-made processes kept ahead of arrivals
+    
+    // Cluster Configuration (cluster-start)
+    int clusterEpochCycles;     // Nodes synchronize every this many cycles
+    int networkDelay;           // Cycles for a dispatch or migration to reach a node
+    int migrationThreshold;     // Load gap that triggers a migration (0 = off)
+    
+    // Per-core data cache model
+    bool cacheEnabled;
+    int cacheLineSize;          // Bytes per line (power of two)
+    int cacheL1Sets;            // Sets per level (power of two)
+    int cacheL1Ways;
+    int cacheL2Sets;
+    int cacheL2Ways;
+    std::string cachePolicy;    // Replacement: "lru" or "plru"
+    int cacheL2Latency;         // Stall cycles for an L1 miss that hits L2
+    int cacheMemoryLatency;     // Stall cycles for a miss in both levels
+    std::string cacheFlush;     // On context switch: "all", "l1" or "none"
+    
+    // Memory Configuration
+    size_t maxOverallMem;       // Total bytes the memory backend manages
+    size_t minMemPerProc;
+    size_t maxMemPerProc;
+    std::vector<int> memSizeClasses;    // Discrete process sizes (slab backend)
     
     // Process Configuration
+    int heapOpsPercent;         // Share of PRINT slots turned into MALLOC/FREE
+    int heapMaxAlloc;           // Largest MALLOC size, in bytes
+    int syscallOpsPercent;      // Share of PRINT slots turned into SYSCALLs
+    int syscallCost;            // Kernel-mode cycles charged per SYSCALL
+    int syscallSleepMax;        // Longest generated sleep, in cycles
+    int syscallIoCycles;        // Cycles a generated IO call blocks for
     int minInstructions;
     int maxInstructions;
     int delayPerExec;          // CPU cycles to wait before next instruction (0-2^32)
@@ -24,9 +81,45 @@ struct SystemConfig {
     // Constructor with defaults
     SystemConfig() 
         : numCPUs(4),
+          smtThreads(1),
+          smtContention(0.3),
+          smtPlacement("spread"),
+          cstatePreferShallow(false),
+          cycleMs(100),
+          tickPolicy("burst"),
+          profileInterval(0),
+          autoscale(false),
+          autoscaleTargetWait(20),
+          autoscaleMinCPUs(1),
+          autoscaleMaxCPUs(128),
+          autoscaleInterval(50),
           schedulerType("fcfs"),
           quantumCycles(5),
+          dagPriority("fifo"),
           batchProcessFreq(3),
+          prefetchPoolSize(16),
+          clusterEpochCycles(10),
+          networkDelay(10),
+          migrationThreshold(0),
+          cacheEnabled(false),
+          cacheLineSize(64),
+          cacheL1Sets(64),
+          cacheL1Ways(8),
+          cacheL2Sets(512),
+          cacheL2Ways(8),
+          cachePolicy("lru"),
+          cacheL2Latency(4),
+          cacheMemoryLatency(20),
+          cacheFlush("l1"),
+          maxOverallMem(16384),
+          minMemPerProc(4096),
+          maxMemPerProc(4096),
+          heapOpsPercent(0),
+          heapMaxAlloc(256),
+          syscallOpsPercent(0),
+          syscallCost(2),
+          syscallSleepMax(10),
+          syscallIoCycles(10),
           minInstructions(100),
           maxInstructions(1000),
           delayPerExec(0) {}  // Default: 0 (execute one instruction per cycle)
@@ -35,13 +128,56 @@ struct SystemConfig {
     void display() const {
         std::cout << "\n=== System Configuration ===\n";
         std::cout << "Number of CPUs: " << numCPUs << "\n";
-        //std::cout << "CPU Cycle Time: 100 ms (fixed)\n";
+        if (smtThreads > 1) {
+            std::cout << "SMT: " << smtThreads << " threads per core, contention " << smtContention
+                      << ", " << smtPlacement << " placement\n";
+        }
+        if (autoscale) {
+            std::cout << "Autoscale: " << autoscaleMinCPUs << "-" << autoscaleMaxCPUs
+                      << " CPUs, wait p99 target " << autoscaleTargetWait
+                      << " cycles, every " << autoscaleInterval << " cycles\n";
+        }
+        if (!cstateThresholds.empty()) {
+            std::cout << "C-states:";
+            for (size_t i = 0; i < cstateThresholds.size(); i++) {
+                std::cout << " C" << (i + 1) << " after " << cstateThresholds[i]
+                          << " (exit " << cstateExitLatencies[i] << ")";
+            }
+            std::cout << (cstatePreferShallow ? ", prefer shallow" : "") << "\n";
+        }
+        std::cout << "CPU Cycle Time: " << cycleMs << " ms (overrun policy: " << tickPolicy << ")\n";
+        if (profileInterval > 0) {
+            std::cout << "Profiler: sampling every " << profileInterval << " cycles\n";
+        }
         std::cout << "Scheduler Type: " << schedulerType << "\n";
         std::cout << "Quantum Cycles: " << quantumCycles << "\n";
+        std::cout << "DAG Priority: " << dagPriority << "\n";
         std::cout << "Batch Process Frequency: " << batchProcessFreq << "\n";
+        std::cout << "Prefetch Pool Size: " << prefetchPoolSize << "\n";
+        if (cacheEnabled) {
+            std::cout << "Data Cache: L1 " << cacheL1Sets << "x" << cacheL1Ways
+                      << ", L2 " << cacheL2Sets << "x" << cacheL2Ways << ", " << cacheLineSize
+                      << " B lines, " << cachePolicy << ", flush " << cacheFlush << "\n";
+        }
+        std::cout << "Max Overall Memory: " << maxOverallMem << " B\n";
+        if (!memSizeClasses.empty()) {
+            std::cout << "Memory Size Classes:";
+            for (int size : memSizeClasses) std::cout << " " << size;
+            std::cout << " B\n";
+        } else {
+            std::cout << "Memory per Process: " << minMemPerProc << "-" << maxMemPerProc << " B\n";
+        }
         std::cout << "Min Instructions: " << minInstructions << "\n";
         std::cout << "Max Instructions: " << maxInstructions << "\n";
         std::cout << "Delay per Exec: " << delayPerExec << " cycles\n";
+        if (heapOpsPercent > 0) {
+            std::cout << "Heap Operations: " << heapOpsPercent << "% of PRINTs, up to "
+                      << heapMaxAlloc << " B per MALLOC\n";
+        }
+        if (syscallOpsPercent > 0) {
+            std::cout << "System Calls: " << syscallOpsPercent << "% of PRINTs, " << syscallCost
+                      << " kernel cycles each\n";
+        }
         std::cout << "\n============================\n\n";
         /*
         if (delayPerExec == 0) {
@@ -58,9 +194,16 @@ struct SystemConfig {
         bool valid = true;
         
         // Validate scheduler type
-        if (schedulerType != "fcfs" && schedulerType != "rr") {
+        if (schedulerType != "fcfs" && schedulerType != "rr" && schedulerType != "backfill") {
             std::cerr << "ERROR: Invalid scheduler type '" << schedulerType << "'\n";
-            std::cerr << "       Must be 'fcfs' or 'rr'\n";
+            std::cerr << "       Must be 'fcfs', 'rr' or 'backfill'\n";
+            valid = false;
+        }
+        
+        // Validate DAG priority
+        if (dagPriority != "fifo" && dagPriority != "critical-path") {
+            std::cerr << "ERROR: Invalid DAG priority '" << dagPriority << "'\n";
+            std::cerr << "       Must be 'fifo' or 'critical-path'\n";
             valid = false;
         }
         
@@ -71,6 +214,63 @@ struct SystemConfig {
             valid = false;
         }
         
+        // Validate SMT grouping
+        if (smtThreads != 1 && smtThreads != 2 && smtThreads != 4) {
+            std::cerr << "ERROR: Invalid SMT threads (" << smtThreads << ")\n";
+            std::cerr << "       Must be 1, 2 or 4\n";
+            valid = false;
+        }
+        if (smtContention < 0.0 || smtContention > 1.0) {
+            std::cerr << "ERROR: Invalid SMT contention (" << smtContention << ")\n";
+            std::cerr << "       Must be between 0 and 1\n";
+            valid = false;
+        }
+        if (smtPlacement != "spread" && smtPlacement != "pack") {
+            std::cerr << "ERROR: Invalid SMT placement '" << smtPlacement << "'\n";
+            std::cerr << "       Must be 'spread' or 'pack'\n";
+            valid = false;
+        }
+        
+        // Validate idle states: thresholds strictly increasing, one latency each
+        bool cstatesValid = (cstateThresholds.size() == cstateExitLatencies.size());
+        for (size_t i = 0; cstatesValid && i < cstateThresholds.size(); i++) {
+            if (cstateThresholds[i] < 1 || cstateExitLatencies[i] < 0 ||
+                (i > 0 && cstateThresholds[i] <= cstateThresholds[i - 1])) {
+                cstatesValid = false;
+            }
+        }
+        if (!cstatesValid) {
+            std::cerr << "ERROR: Invalid C-state settings\n";
+            std::cerr << "       Need one exit latency (>= 0) per threshold, thresholds increasing from 1\n";
+            valid = false;
+        }
+        
+        // Validate real-time clock
+        if (cycleMs < 1) {
+            std::cerr << "ERROR: Invalid cycle time (" << cycleMs << " ms)\n";
+            std::cerr << "       Must be at least 1 ms\n";
+            valid = false;
+        }
+        if (tickPolicy != "skip" && tickPolicy != "burst" && tickPolicy != "slow") {
+            std::cerr << "ERROR: Invalid tick policy '" << tickPolicy << "'\n";
+            std::cerr << "       Must be 'skip', 'burst' or 'slow'\n";
+            valid = false;
+        }
+        if (profileInterval < 0) {
+            std::cerr << "ERROR: Invalid profile interval (" << profileInterval << " cycles)\n";
+            std::cerr << "       Must be at least 0 (0 = profiler off)\n";
+            valid = false;
+        }
+        
+        // Validate autoscaling bounds
+        if (autoscale && (autoscaleMinCPUs < 1 || autoscaleMaxCPUs > 128 ||
+                          autoscaleMinCPUs > autoscaleMaxCPUs ||
+                          autoscaleTargetWait < 0 || autoscaleInterval < 1)) {
+            std::cerr << "ERROR: Invalid autoscale settings\n";
+            std::cerr << "       Need 1 <= min <= max <= 128, target >= 0, interval >= 1\n";
+            valid = false;
+        }
+        
         // Validate quantum cycles (for RR)
         if (schedulerType == "rr" && quantumCycles < 1) {
             std::cerr << "ERROR: Invalid quantum cycles (" << quantumCycles << ")\n";
@@ -78,6 +278,77 @@ struct SystemConfig {
             valid = false;
         }
         
+        // Validate prefetch pool
+        if (prefetchPoolSize < 0) {
+            std::cerr << "ERROR: Invalid prefetch pool size (" << prefetchPoolSize << ")\n";
+            std::cerr << "       Must be 0 (disabled) or more\n";
+            valid = false;
+        }
+        
+        // Validate cluster timing
+        if (clusterEpochCycles < 1 || networkDelay < 0 || migrationThreshold < 0) {
+            std::cerr << "ERROR: Invalid cluster settings\n";
+            std::cerr << "       Epoch must be at least 1 cycle, delay and threshold at least 0\n";
+            valid = false;
+        }
+        
+        // Validate cache geometry
+        if (cacheEnabled) {
+            auto powerOfTwo = [](int n) { return n > 0 && (n & (n - 1)) == 0; };
+            bool plru = (cachePolicy == "plru");
+            if (!powerOfTwo(cacheLineSize) || !powerOfTwo(cacheL1Sets) || !powerOfTwo(cacheL2Sets) ||
+                cacheL1Ways < 1 || cacheL1Ways > 16 || cacheL2Ways < 1 || cacheL2Ways > 16 ||
+                (plru && (!powerOfTwo(cacheL1Ways) || !powerOfTwo(cacheL2Ways)))) {
+                std::cerr << "ERROR: Invalid cache geometry\n";
+                std::cerr << "       Line size and set counts must be powers of two, ways 1-16\n";
+                std::cerr << "       (powers of two for plru)\n";
+                valid = false;
+            }
+            if (cachePolicy != "lru" && !plru) {
+                std::cerr << "ERROR: Invalid cache policy '" << cachePolicy << "'\n";
+                std::cerr << "       Must be 'lru' or 'plru'\n";
+                valid = false;
+            }
+            if (cacheFlush != "all" && cacheFlush != "l1" && cacheFlush != "none") {
+                std::cerr << "ERROR: Invalid cache flush '" << cacheFlush << "'\n";
+                std::cerr << "       Must be 'all', 'l1' or 'none'\n";
+                valid = false;
+            }
+            if (cacheL2Latency < 0 || cacheMemoryLatency < 0) {
+                std::cerr << "ERROR: Invalid cache latency\n";
+                std::cerr << "       Must be at least 0 cycles\n";
+                valid = false;
+            }
+        }
+        
+        // Validate memory sizes
+        bool classesValid = true;
+        for (int size : memSizeClasses) {
+            if (size < 1 || (size_t)size > maxOverallMem) classesValid = false;
+        }
+        if (maxOverallMem < 1 || minMemPerProc < 1 || maxMemPerProc < minMemPerProc ||
+            maxMemPerProc > maxOverallMem || !classesValid) {
+            std::cerr << "ERROR: Invalid memory settings\n";
+            std::cerr << "       Need 1 <= min-mem-per-proc <= max-mem-per-proc <= max-overall-mem\n";
+            std::cerr << "       and every size class within max-overall-mem\n";
+            valid = false;
+        }
+        
+        // Validate heap workload
+        if (heapOpsPercent < 0 || heapOpsPercent > 100 || heapMaxAlloc < 1) {
+            std::cerr << "ERROR: Invalid heap settings\n";
+            std::cerr << "       heap-ops must be 0-100 and heap-max-alloc at least 1\n";
+            valid = false;
+        }
+        
+        // Validate system calls
+        if (syscallOpsPercent < 0 || syscallOpsPercent > 100 || syscallCost < 0 ||
+            syscallSleepMax < 1 || syscallIoCycles < 0) {
+            std::cerr << "ERROR: Invalid system call settings\n";
+            std::cerr << "       syscall-ops must be 0-100, cost and IO cycles at least 0, sleep max at least 1\n";
+            valid = false;
+        }
+        
         // Validate instruction range
         if (minInstructions < 1 || maxInstructions < minInstructions) {
             std::cerr << "ERROR: Invalid instruction range\n";
@@ -124,10 +395,99 @@ public:
     }
 
 private:
+    // Parse a comma-separated list such as "1,10,50"
+    static std::vector<int> parseIntList(const std::string& value) {
+        std::vector<int> list;
+        std::istringstream iss(value);
+        std::string item;
+        while (std::getline(iss, item, ',')) {
+            if (!item.empty()) {
+                list.push_back(std::stoi(item));
+            }
+        }
+        return list;
+    }
+
     static void parseConfigValue(SystemConfig& config, const std::string& key, const std::string& value) {
         if (key == "num-cpu" || key == "num_cpu") {
             config.numCPUs = std::stoi(value);
         }
+        else if (key == "smt-threads" || key == "smt_threads") {
+            config.smtThreads = std::stoi(value);
+        }
+        else if (key == "smt-contention" || key == "smt_contention") {
+            config.smtContention = std::stod(value);
+        }
+        else if (key == "smt-placement" || key == "smt_placement") {
+            config.smtPlacement = value;
+        }
+        else if (key == "cstate-thresholds" || key == "cstate_thresholds") {
+            config.cstateThresholds = parseIntList(value);
+        }
+        else if (key == "cstate-exit-latency" || key == "cstate_exit_latency") {
+            config.cstateExitLatencies = parseIntList(value);
+        }
+        else if (key == "cstate-prefer-shallow" || key == "cstate_prefer_shallow") {
+            config.cstatePreferShallow = (value == "true" || value == "1" || value == "on");
+        }
+        else if (key == "profile-interval" || key == "profile_interval") {
+            config.profileInterval = std::stoi(value);
+        }
+        else if (key == "cycle-ms" || key == "cycle_ms") {
+            config.cycleMs = std::stoi(value);
+        }
+        else if (key == "tick-policy" || key == "tick_policy") {
+            std::string lowerValue = value;
+            for (char& c : lowerValue) {
+                c = std::tolower(c);
+            }
+            config.tickPolicy = lowerValue;
+        }
+        else if (key == "cache") {
+            config.cacheEnabled = (value == "true" || value == "1" || value == "on");
+        }
+        else if (key == "cache-line" || key == "cache_line") {
+            config.cacheLineSize = std::stoi(value);
+        }
+        else if (key == "cache-l1-sets" || key == "cache_l1_sets") {
+            config.cacheL1Sets = std::stoi(value);
+        }
+        else if (key == "cache-l1-ways" || key == "cache_l1_ways") {
+            config.cacheL1Ways = std::stoi(value);
+        }
+        else if (key == "cache-l2-sets" || key == "cache_l2_sets") {
+            config.cacheL2Sets = std::stoi(value);
+        }
+        else if (key == "cache-l2-ways" || key == "cache_l2_ways") {
+            config.cacheL2Ways = std::stoi(value);
+        }
+        else if (key == "cache-policy" || key == "cache_policy") {
+            config.cachePolicy = value;
+        }
+        else if (key == "cache-l2-latency" || key == "cache_l2_latency") {
+            config.cacheL2Latency = std::stoi(value);
+        }
+        else if (key == "cache-mem-latency" || key == "cache_mem_latency") {
+            config.cacheMemoryLatency = std::stoi(value);
+        }
+        else if (key == "cache-flush" || key == "cache_flush") {
+            config.cacheFlush = value;
+        }
+        else if (key == "autoscale") {
+            config.autoscale = (value == "true" || value == "1" || value == "on");
+        }
+        else if (key == "autoscale-target-wait" || key == "autoscale_target_wait") {
+            config.autoscaleTargetWait = std::stoi(value);
+        }
+        else if (key == "autoscale-min-cpu" || key == "autoscale_min_cpu") {
+            config.autoscaleMinCPUs = std::stoi(value);
+        }
+        else if (key == "autoscale-max-cpu" || key == "autoscale_max_cpu") {
+            config.autoscaleMaxCPUs = std::stoi(value);
+        }
+        else if (key == "autoscale-interval" || key == "autoscale_interval") {
+            config.autoscaleInterval = std::stoi(value);
+        }
         else if (key == "scheduler" || key == "scheduler-type") {
             // Convert to lowercase for comparison
             std::string lowerValue = value;
@@ -136,12 +496,61 @@ private:
             }
             config.schedulerType = lowerValue;
         }
+        else if (key == "dag-priority" || key == "dag_priority") {
+            std::string lowerValue = value;
+            for (char& c : lowerValue) {
+                c = std::tolower(c);
+            }
+            config.dagPriority = lowerValue;
+        }
         else if (key == "quantum-cycles" || key == "quantum_cycles") {
             config.quantumCycles = std::stoi(value);
         }
         else if (key == "batch-process-freq" || key == "batch_process_freq") {
             config.batchProcessFreq = std::stoi(value);
         }
+        else if (key == "prefetch-pool-size" || key == "prefetch_pool_size") {
+            config.prefetchPoolSize = std::stoi(value);
+        }
+        else if (key == "cluster-epoch" || key == "cluster_epoch") {
+            config.clusterEpochCycles = std::stoi(value);
+        }
+        else if (key == "network-delay" || key == "network_delay") {
+            config.networkDelay = std::stoi(value);
+        }
+        else if (key == "migration-threshold" || key == "migration_threshold") {
+            config.migrationThreshold = std::stoi(value);
+        }
+        else if (key == "max-overall-mem" || key == "max_overall_mem") {
+            config.maxOverallMem = std::stoul(value);
+        }
+        else if (key == "min-mem-per-proc" || key == "min_mem_per_proc") {
+            config.minMemPerProc = std::stoul(value);
+        }
+        else if (key == "max-mem-per-proc" || key == "max_mem_per_proc") {
+            config.maxMemPerProc = std::stoul(value);
+        }
+        else if (key == "mem-size-classes" || key == "mem_size_classes") {
+            config.memSizeClasses = parseIntList(value);
+        }
+        else if (key == "heap-ops" || key == "heap_ops") {
+            config.heapOpsPercent = std::stoi(value);
+        }
+        else if (key == "heap-max-alloc" || key == "heap_max_alloc") {
+            config.heapMaxAlloc = std::stoi(value);
+        }
+        else if (key == "syscall-ops" || key == "syscall_ops") {
+            config.syscallOpsPercent = std::stoi(value);
+        }
+        else if (key == "syscall-cost" || key == "syscall_cost") {
+            config.syscallCost = std::stoi(value);
+        }
+        else if (key == "syscall-sleep-max" || key == "syscall_sleep_max") {
+            config.syscallSleepMax = std::stoi(value);
+        }
+        else if (key == "syscall-io-cycles" || key == "syscall_io_cycles") {
+            config.syscallIoCycles = std::stoi(value);
+        }
         else if (key == "min-ins" || key == "min_instructions") {
             config.minInstructions = std::stoi(value);
         }
@@ -7,14 +7,30 @@
 #include <vector>
 #include <ctime>
 #include <cstdlib>
+#include <algorithm>
+#include <cstdint>
+#include <chrono>
+#include <sstream>
+#include "ProcessHeap.h"
+
+class ProcessList;
 
 // Process - Represents a single process in the system
 class Process {
 public:
+    // SYSCALL numbers
+    enum SyscallNumber {
+        SYS_YIELD = 0,      // Give up the core, back to the ready queue
+        SYS_GETPID = 1,     // Result register = process ID
+        SYS_SLEEP = 2,      // Block for <arg> cycles
+        SYS_IO = 3          // Block for <arg> cycles of IO
+    };
+
     enum ProcessState {
         READY,      // Waiting in queue
         RUNNING,    // Currently executing
-        WAITING,    // Blocked (optional, for future use)
+        WAITING,    // Blocked on unfinished DAG parents, or sleeping/in IO after a SYSCALL
+        SUSPENDED,  // Paused by the operator (process-suspend)
         FINISHED    // Completed execution
     };
 
@@ -44,9 +60,54 @@ private:
     // Core assignment (for multi-core simulation)
     int assignedCore;
     
+    // Memory to request from the MemoryManager on arrival
+    size_t memoryRequired;
+    
+    // Simulated cycle stamps (-1 until reached)
+    int arrivalCycle;
+    int finishCycle;
+    
+    // Dependency DAG (see Scheduler::submitDag)
+    std::vector<Process*> parents;
+    std::vector<Process*> dependents;
+    int unfinishedParents;
+    long long criticalPathLength;   // Instructions on the longest path from here to a sink
+    int dagRunIndex;                // Which submitted DAG this belongs to (-1 for none)
+    
+    // Batch job sizing (used by the "backfill" scheduler)
+    int requiredCores;
+    int estimatedInstructions;      // User estimate; defaults to the real length
+    int expectedEndCycle;           // Start cycle + estimate while running
+    int readySinceCycle;            // When it last entered the ready queue
+    int cpuCycles;                  // Cycles spent on a core, busy-waits included
+    
+    // Data cache counters (see CPUCore cache model)
+    long long cacheAccesses;        // Lines touched
+    long long cacheMisses;          // Lines that missed in L1
+    
+    // System calls
+    int systemCycles;               // Cycles spent in kernel mode (part of cpuCycles)
+    int wakeCycle;                  // When a sleeping/IO-blocked process becomes ready (-1 = not sleeping)
+    int lastSyscall;
+    int lastSyscallArg;
+    
+    // Heap for MALLOC/FREE, inside this process's memory region
+    ProcessHeap heap;
+    std::vector<long long> heapHandles;     // Offset returned by each MALLOC (-1 = NULL or freed)
+    size_t heapGrowthRequest;               // Region size a stalled MALLOC is waiting for (0 = none)
+    bool heapGrowthDenied;                  // The last growth failed; the retry returns NULL
+    long long lastHeapOpNanos;
+    std::string heapNote;                   // Result of the last MALLOC/FREE, for the log
+    
     // Logging
     std::string logFilePath;
 
+    // Intrusive links, owned by whichever ProcessList currently holds this process
+    friend class ProcessList;
+    Process* listPrev;
+    Process* listNext;
+    const ProcessList* listOwner;
+
 public:
     // Constructor
     Process(std::string name, int id, int instructionCount, std::string arrival)
@@ -63,7 +124,30 @@ public:
           startTime(""),
           finishTime(""),
           assignedCore(-1),
-          logFilePath("") {
+          memoryRequired(0),
+          arrivalCycle(-1),
+          finishCycle(-1),
+          unfinishedParents(0),
+          criticalPathLength(instructionCount),
+          dagRunIndex(-1),
+          requiredCores(1),
+          estimatedInstructions(instructionCount),
+          expectedEndCycle(-1),
+          readySinceCycle(-1),
+          cpuCycles(0),
+          cacheAccesses(0),
+          cacheMisses(0),
+          systemCycles(0),
+          wakeCycle(-1),
+          lastSyscall(-1),
+          lastSyscallArg(0),
+          heapGrowthRequest(0),
+          heapGrowthDenied(false),
+          lastHeapOpNanos(0),
+          logFilePath(""),
+          listPrev(nullptr),
+          listNext(nullptr),
+          listOwner(nullptr) {
         // Instructions will be generated separately
     }
 
@@ -78,10 +162,56 @@ public:
     std::string getStartTime() const { return startTime; }
     std::string getFinishTime() const { return finishTime; }
     int getAssignedCore() const { return assignedCore; }
+    size_t getMemoryRequired() const { return memoryRequired; }
+    int getArrivalCycle() const { return arrivalCycle; }
+    int getFinishCycle() const { return finishCycle; }
+    const std::vector<Process*>& getParents() const { return parents; }
+    const std::vector<Process*>& getDependents() const { return dependents; }
+    int getUnfinishedParents() const { return unfinishedParents; }
+    long long getCriticalPathLength() const { return criticalPathLength; }
+    int getDagRunIndex() const { return dagRunIndex; }
+    int getRequiredCores() const { return requiredCores; }
+    int getEstimatedInstructions() const { return estimatedInstructions; }
+    int getExpectedEndCycle() const { return expectedEndCycle; }
+    int getReadySinceCycle() const { return readySinceCycle; }
+    int getCpuCycles() const { return cpuCycles; }
     std::string getLogFilePath() const { return logFilePath; }
 
     // Setters
     void setState(ProcessState newState) { currentState = newState; }
+    void setArrivalTime(std::string time) { arrivalTime = time; }
+    void setMemoryRequired(size_t bytes) { memoryRequired = bytes; }
+    void setArrivalCycle(int cycle) { arrivalCycle = cycle; }
+    void setFinishCycle(int cycle) { finishCycle = cycle; }
+    void setCriticalPathLength(long long length) { criticalPathLength = length; }
+    void setDagRunIndex(int index) { dagRunIndex = index; }
+    void setRequiredCores(int cores) { requiredCores = cores; }
+    void setEstimatedInstructions(int estimate) { estimatedInstructions = estimate; }
+    void setExpectedEndCycle(int cycle) { expectedEndCycle = cycle; }
+    void setReadySinceCycle(int cycle) { readySinceCycle = cycle; }
+    void countCpuCycle() { cpuCycles++; }
+
+    // Record that this process may only start after 'parent' finishes
+    void addParent(Process* parent) {
+        parents.push_back(parent);
+        parent->dependents.push_back(this);
+        unfinishedParents++;
+    }
+
+    // A parent finished (or was killed); returns true once nothing blocks this process
+    bool releaseParent(Process* parent) {
+        parents.erase(std::remove(parents.begin(), parents.end(), parent), parents.end());
+        if (unfinishedParents > 0) unfinishedParents--;
+        return unfinishedParents == 0;
+    }
+
+    // Drop all dependent links once they have been released
+    void clearDependents() { dependents.clear(); }
+
+    // Forget a dependent that was removed from the system
+    void removeDependent(Process* child) {
+        dependents.erase(std::remove(dependents.begin(), dependents.end(), child), dependents.end());
+    }
     void setStartTime(std::string time) { startTime = time; }
     void setFinishTime(std::string time) { finishTime = time; }
     void setAssignedCore(int core) { assignedCore = core; }
@@ -107,6 +237,43 @@ public:
         return "";
     }
 
+    // Simulated address space: each process owns a 1 MiB region, with X at
+    // its base and the PRINT message in a string region above it. The
+    // memoryRequired bytes allocated to it start at the base, and heap
+    // offsets are relative to that.
+    static constexpr uint64_t ADDRESS_SPACE_BYTES = 1 << 20;
+    static constexpr uint64_t STRING_REGION_OFFSET = 4096;
+
+    uint64_t getBaseAddress() const { return (uint64_t)processID * ADDRESS_SPACE_BYTES; }
+
+    // Data touched by the current instruction; false if it touches none
+    bool getDataAccess(uint64_t& address, int& bytes) const {
+        if (instructionsExecuted >= (int)instructions.size()) return false;
+        const std::string& instruction = instructions[instructionsExecuted];
+        if (instruction.find("VAR") == 0 || instruction.find("ADD") == 0) {
+            address = getBaseAddress();
+            bytes = sizeof(int);
+            return true;
+        }
+        if (instruction.find("PRINT") == 0) {
+            // The message string is "Value from <name>!"
+            address = getBaseAddress() + STRING_REGION_OFFSET;
+            bytes = (int)processName.size() + 12;
+            return true;
+        }
+        return false;
+    }
+
+    void countCacheAccesses(int lines, int misses) {
+        cacheAccesses += lines;
+        cacheMisses += misses;
+    }
+    long long getCacheAccesses() const { return cacheAccesses; }
+    long long getCacheMisses() const { return cacheMisses; }
+    float getCacheMissRate() const {
+        return cacheAccesses > 0 ? (float)cacheMisses / cacheAccesses * 100.0f : 0.0f;
+    }
+
     // Execute one instruction
     void executeInstruction() {
         if (remainingInstructions > 0 && instructionsExecuted < instructions.size()) {
@@ -128,6 +295,23 @@ public:
                     registerA += valueToAdd;
                 }
             }
+            else if (instruction.find("SYSCALL") == 0) {
+                // SYSCALL n [arg]; the scheduler applies the effect and kernel cost
+                std::istringstream args(instruction.substr(8));
+                lastSyscallArg = 0;
+                args >> lastSyscall >> lastSyscallArg;
+                if (lastSyscall == SYS_GETPID) {
+                    result = processID;
+                }
+            }
+            else if (instruction.find("MALLOC") == 0) {
+                // MALLOC size; stays on this instruction while the region grows
+                if (!executeMalloc(std::stoul(instruction.substr(7)))) return;
+            }
+            else if (instruction.find("FREE") == 0) {
+                // FREE handle, where handle numbers the program's MALLOCs from 0
+                executeFree(std::stoul(instruction.substr(5)));
+            }
             // PRINT doesn't need execution logic, just logged
             
             instructionsExecuted++;
@@ -135,27 +319,160 @@ public:
         }
     }
 
+    // Serve a MALLOC from the heap. Returns false if the heap is full and a
+    // growth request was raised; the instruction is retried after it is served.
+    bool executeMalloc(size_t size) {
+        auto start = std::chrono::steady_clock::now();
+        heap.extend(memoryRequired);
+        long long offset = heap.allocate(size);
+        lastHeapOpNanos = std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now() - start).count();
+        
+        bool done = true;
+        if (offset < 0 && !heapGrowthDenied) {
+            size_t needed = heap.getCapacity() + ProcessHeap::roundUp(size);
+            size_t limit = ADDRESS_SPACE_BYTES;
+            if (needed <= limit) {
+                heapGrowthRequest = std::min(limit, std::max(heap.getCapacity() * 2, needed));
+                heapNote = " | heap full, growing to " + std::to_string(heapGrowthRequest) + " B";
+                done = false;
+            }
+        }
+        if (done) {
+            heapGrowthDenied = false;
+            heapHandles.push_back(offset);
+            if (offset < 0) {
+                heap.countFailure();
+                heapNote = " | ptr = NULL";
+            } else {
+                std::ostringstream note;
+                note << " | ptr = 0x" << std::hex << (getBaseAddress() + offset);
+                heapNote = note.str();
+            }
+        }
+        return done;
+    }
+
+    void executeFree(size_t handle) {
+        auto start = std::chrono::steady_clock::now();
+        bool freed = handle < heapHandles.size() && heapHandles[handle] >= 0 &&
+                     heap.release((size_t)heapHandles[handle]);
+        lastHeapOpNanos = std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now() - start).count();
+        if (freed) {
+            heapHandles[handle] = -1;
+            heapNote = " | freed";
+        } else {
+            heapNote = " | not a live block (ignored)";
+        }
+    }
+
+    void countSystemCycle() { systemCycles++; }
+    int getSystemCycles() const { return systemCycles; }
+    int getUserCycles() const { return cpuCycles - systemCycles; }
+    int getLastSyscall() const { return lastSyscall; }
+    int getLastSyscallArg() const { return lastSyscallArg; }
+    int getResult() const { return result; }
+    int getWakeCycle() const { return wakeCycle; }
+    void setWakeCycle(int cycle) { wakeCycle = cycle; }
+
+    // Called by the scheduler once it has tried to grow the memory region
+    void completeHeapGrowth(bool granted) {
+        heapGrowthRequest = 0;
+        if (granted) {
+            heap.extend(memoryRequired);
+            heap.countGrowth();
+        } else {
+            heapGrowthDenied = true;
+        }
+    }
+
+    // The memory region is gone (the backend could not give it back after a
+    // failed move): every heap block is lost and later FREEs are ignored
+    void loseMemoryRegion() {
+        memoryRequired = 0;
+        heap.clear();
+        std::fill(heapHandles.begin(), heapHandles.end(), -1);
+    }
+
+    size_t getHeapGrowthRequest() const { return heapGrowthRequest; }
+    long long getLastHeapOpNanos() const { return lastHeapOpNanos; }
+    const std::string& getHeapNote() const { return heapNote; }
+    const ProcessHeap& getHeap() const { return heap; }
+
     // Generate instructions for this process
     void generateInstructions(int count) {
+        generateInstructions(count, []() { return rand() % 10 + 1; });
+    }
+
+    // Generate instructions drawing ADD operands from the given source
+    // (lets batch creation use a per-thread RNG instead of the shared rand())
+    template <typename ValueSource>
+    void generateInstructions(int count, ValueSource nextAddValue) {
         instructions.clear();
+        instructions.reserve(count);
         
         // First instruction: VAR X = <random>
         int initialValue = 0;  // initialize to 0
         instructions.push_back("VAR X = " + std::to_string(initialValue));
         
         // Alternate between PRINT and ADD for remaining instructions
+        const std::string printLine = "PRINT \"Value from " + processName + "!\"";
         for (int i = 1; i < count; i++) {
             if (i % 2 == 1) {
                 // Odd positions: PRINT
-                instructions.push_back("PRINT \"Value from " + processName + "!\"");
+                instructions.push_back(printLine);
             } else {
                 // Even positions: ADD
-                int valueToAdd = rand() % 10 + 1;  // Random 1-10
+                int valueToAdd = nextAddValue();  // Random 1-10
                 instructions.push_back("ADD " + std::to_string(valueToAdd));
             }
         }
     }
 
+    // Turn some PRINTs into MALLOC/FREE: each chosen slot frees a random
+    // live block or allocates 1..maxAlloc bytes
+    template <typename RNG>
+    void addHeapOperations(int percent, int maxAlloc, RNG& rng) {
+        std::vector<int> live;
+        int handles = 0;
+        for (size_t i = 1; i < instructions.size(); i++) {
+            if (instructions[i].find("PRINT") != 0 || (int)(rng() % 100) >= percent) continue;
+            if (!live.empty() && rng() % 2 == 0) {
+                size_t pick = rng() % live.size();
+                instructions[i] = "FREE " + std::to_string(live[pick]);
+                live.erase(live.begin() + pick);
+            } else {
+                instructions[i] = "MALLOC " + std::to_string(1 + rng() % maxAlloc);
+                live.push_back(handles++);
+            }
+        }
+    }
+
+    // Turn some PRINTs into SYSCALLs of a random kind. Sleeps last
+    // 1..maxSleep cycles, IO requests ioCycles.
+    template <typename RNG>
+    void addSyscalls(int percent, int maxSleep, int ioCycles, RNG& rng) {
+        for (size_t i = 1; i < instructions.size(); i++) {
+            if (instructions[i].find("PRINT") != 0 || (int)(rng() % 100) >= percent) continue;
+            int number = (int)(rng() % 4);
+            std::string instruction = "SYSCALL " + std::to_string(number);
+            if (number == SYS_SLEEP) {
+                instruction += " " + std::to_string(1 + rng() % maxSleep);
+            } else if (number == SYS_IO) {
+                instruction += " " + std::to_string(ioCycles);
+            }
+            instructions[i] = instruction;
+        }
+    }
+
+    // Resume from a saved position (a migrated process rebuilt from its seed)
+    void restoreProgress(int executed, int valueOfX) {
+        instructionsExecuted = std::min(executed, totalInstructions);
+        remainingInstructions = totalInstructions - instructionsExecuted;
+        registerA = valueOfX;
+    }
+
     // Get current value of X
     int getRegisterA() const { return registerA; }
 
@@ -176,6 +493,7 @@ public:
             case READY: return "Ready";
             case RUNNING: return "Running";
             case WAITING: return "Waiting";
+            case SUSPENDED: return "Suspended";
             case FINISHED: return "Finished";
             default: return "Unknown";
         }
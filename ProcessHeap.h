@@ -0,0 +1,129 @@
+#ifndef PROCESSHEAP_H
+#define PROCESSHEAP_H
+
+#include <cstddef>
+#include <map>
+#include <iterator>
+#include <algorithm>
+
+// ProcessHeap - First-fit allocator over a process's own memory region
+// Offsets are relative to the start of the region. Free blocks are kept by
+// offset so neighbours coalesce on free.
+class ProcessHeap {
+private:
+    static constexpr size_t ALIGNMENT = 8;
+
+    size_t capacity;
+    size_t used;
+    std::map<size_t, size_t> freeBlocks;    // Offset -> size
+    std::map<size_t, size_t> liveBlocks;    // Offset -> size
+
+    // Statistics
+    long long allocations;
+    long long failures;
+    long long frees;
+    int growths;
+
+public:
+    ProcessHeap() : capacity(0), used(0), allocations(0), failures(0), frees(0), growths(0) {}
+
+    // Bytes actually reserved for a request
+    static size_t roundUp(size_t size) {
+        return std::max(ALIGNMENT, (size + ALIGNMENT - 1) / ALIGNMENT * ALIGNMENT);
+    }
+
+    // Offset of a new block, or -1 if no free block is large enough
+    long long allocate(size_t size) {
+        size = roundUp(size);
+        for (auto it = freeBlocks.begin(); it != freeBlocks.end(); ++it) {
+            if (it->second < size) continue;
+            size_t offset = it->first;
+            size_t remaining = it->second - size;
+            freeBlocks.erase(it);
+            if (remaining > 0) freeBlocks[offset + size] = remaining;
+            liveBlocks[offset] = size;
+            used += size;
+            allocations++;
+            return (long long)offset;
+        }
+        return -1;
+    }
+
+    // Returns false for an offset that is not a live block (double or wild free)
+    bool release(size_t offset) {
+        auto live = liveBlocks.find(offset);
+        if (live == liveBlocks.end()) return false;
+        size_t size = live->second;
+        liveBlocks.erase(live);
+        used -= size;
+        frees++;
+
+        // Coalesce with the following and preceding free blocks
+        auto next = freeBlocks.lower_bound(offset);
+        if (next != freeBlocks.end() && next->first == offset + size) {
+            size += next->second;
+            next = freeBlocks.erase(next);
+        }
+        if (next != freeBlocks.begin()) {
+            auto prev = std::prev(next);
+            if (prev->first + prev->second == offset) {
+                prev->second += size;
+                return true;
+            }
+        }
+        freeBlocks[offset] = size;
+        return true;
+    }
+
+    // Extend the region to newCapacity bytes (the new tail becomes free)
+    void extend(size_t newCapacity) {
+        if (newCapacity <= capacity) return;
+        size_t offset = capacity;
+        size_t size = newCapacity - capacity;
+        capacity = newCapacity;
+        if (!freeBlocks.empty()) {
+            auto last = std::prev(freeBlocks.end());
+            if (last->first + last->second == offset) {
+                last->second += size;
+                return;
+            }
+        }
+        freeBlocks[offset] = size;
+    }
+
+    // Forget every block and the region itself (statistics are kept)
+    void clear() {
+        capacity = 0;
+        used = 0;
+        freeBlocks.clear();
+        liveBlocks.clear();
+    }
+
+    void countFailure() { failures++; }
+    void countGrowth() { growths++; }
+
+    size_t getCapacity() const { return capacity; }
+    size_t getUsed() const { return used; }
+    size_t getFree() const { return capacity - used; }
+    size_t getLargestFreeBlock() const {
+        size_t largest = 0;
+        for (const auto& block : freeBlocks) {
+            largest = std::max(largest, block.second);
+        }
+        return largest;
+    }
+
+    // 1 - largest free block / free bytes (0 = one contiguous hole)
+    double getFragmentation() const {
+        size_t freeBytes = getFree();
+        return freeBytes > 0 ? 1.0 - (double)getLargestFreeBlock() / freeBytes : 0.0;
+    }
+
+    long long getAllocations() const { return allocations; }
+    long long getFailures() const { return failures; }
+    long long getFrees() const { return frees; }
+    int getGrowths() const { return growths; }
+    int getLiveBlocks() const { return (int)liveBlocks.size(); }
+};
+
+#endif // PROCESSHEAP_H
@@ -0,0 +1,118 @@
+#ifndef PROCESS_LIST_H
+#define PROCESS_LIST_H
+
+#include "Process.h"
+
+// ProcessList - Intrusive doubly-linked list of processes
+// Links live inside Process, so any process can be unlinked in O(1)
+// without searching. A process belongs to at most one list at a time.
+class ProcessList {
+private:
+    Process* head;
+    Process* tail;
+    int count;
+
+public:
+    ProcessList() : head(nullptr), tail(nullptr), count(0) {}
+
+    // Lists only link processes, they never own them
+    ProcessList(const ProcessList&) = delete;
+    ProcessList& operator=(const ProcessList&) = delete;
+
+    bool empty() const { return count == 0; }
+    int size() const { return count; }
+    Process* front() const { return head; }
+    Process* back() const { return tail; }
+
+    // Process after p in this list (nullptr at the tail)
+    Process* nextOf(const Process* p) const {
+        return contains(p) ? p->listNext : nullptr;
+    }
+
+    // Process before p in this list (nullptr at the head)
+    Process* prevOf(const Process* p) const {
+        return contains(p) ? p->listPrev : nullptr;
+    }
+
+    // Check membership in O(1)
+    bool contains(const Process* p) const {
+        return p && p->listOwner == this;
+    }
+
+    // Append a process at the tail
+    void pushBack(Process* p) {
+        p->listOwner = this;
+        p->listPrev = tail;
+        p->listNext = nullptr;
+        if (tail) tail->listNext = p;
+        else head = p;
+        tail = p;
+        count++;
+    }
+
+    // Insert a process keeping the list sorted by descending key.
+    // Equal keys keep arrival order; the scan starts from the tail.
+    template <typename KeyFn>
+    void insertSorted(Process* p, KeyFn key) {
+        Process* after = tail;
+        while (after && key(after) < key(p)) {
+            after = after->listPrev;
+        }
+        if (!after) {
+            pushFront(p);
+            return;
+        }
+        
+        p->listOwner = this;
+        p->listPrev = after;
+        p->listNext = after->listNext;
+        if (after->listNext) after->listNext->listPrev = p;
+        else tail = p;
+        after->listNext = p;
+        count++;
+    }
+
+    // Insert a process at the head
+    void pushFront(Process* p) {
+        p->listOwner = this;
+        p->listPrev = nullptr;
+        p->listNext = head;
+        if (head) head->listPrev = p;
+        else tail = p;
+        head = p;
+        count++;
+    }
+
+    // Remove and return the head (nullptr if empty)
+    Process* popFront() {
+        Process* p = head;
+        if (p) remove(p);
+        return p;
+    }
+
+    // Unlink a process from anywhere in the list in O(1)
+    bool remove(Process* p) {
+        if (!contains(p)) return false;
+        
+        if (p->listPrev) p->listPrev->listNext = p->listNext;
+        else head = p->listNext;
+        if (p->listNext) p->listNext->listPrev = p->listPrev;
+        else tail = p->listPrev;
+        
+        p->listPrev = nullptr;
+        p->listNext = nullptr;
+        p->listOwner = nullptr;
+        count--;
+        return true;
+    }
+
+    // Visit every process from head to tail
+    template <typename Visitor>
+    void forEach(Visitor visit) const {
+        for (Process* p = head; p; p = p->listNext) {
+            visit(p);
+        }
+    }
+};
+
+#endif // PROCESS_LIST_H
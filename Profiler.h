@@ -0,0 +1,239 @@
+#ifndef PROFILER_H
+#define PROFILER_H
+
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <map>
+#include <vector>
+#include <mutex>
+#include <thread>
+#include <chrono>
+#include <fstream>
+#include <iostream>
+#include <iomanip>
+#include <algorithm>
+
+// SpscRing - Bounded lock-free queue for one producer and one consumer thread
+template <typename T, size_t CAPACITY>
+class SpscRing {
+private:
+    static_assert((CAPACITY & (CAPACITY - 1)) == 0, "capacity must be a power of two");
+
+    alignas(64) std::atomic<uint64_t> head;     // Next slot to read (consumer)
+    alignas(64) std::atomic<uint64_t> tail;     // Next slot to write (producer)
+    T slots[CAPACITY];
+
+public:
+    SpscRing() : head(0), tail(0) {}
+
+    // False when full; the item is not stored
+    bool push(const T& item) {
+        uint64_t t = tail.load(std::memory_order_relaxed);
+        if (t - head.load(std::memory_order_acquire) >= CAPACITY) return false;
+        slots[t & (CAPACITY - 1)] = item;
+        tail.store(t + 1, std::memory_order_release);
+        return true;
+    }
+
+    bool pop(T& item) {
+        uint64_t h = head.load(std::memory_order_relaxed);
+        if (h == tail.load(std::memory_order_acquire)) return false;
+        item = slots[h & (CAPACITY - 1)];
+        head.store(h + 1, std::memory_order_release);
+        return true;
+    }
+};
+
+// ProfileSample - What one core was running at a sampling point
+struct ProfileSample {
+    int pid;
+    int pc;                 // Instruction being issued, waited on, or (in kernel mode) the SYSCALL
+    uint8_t opcode;         // Profiler::Opcode
+    uint8_t state;          // Profiler::State
+    int8_t syscall;         // SYSCALL number in kernel mode, else -1
+    char name[25];          // Process name, truncated
+};
+
+/**
+ * Profiler - Samples what simulated processes spend their cycles on
+ *
+ * Every 'interval' cycles the scheduler records each busy core's process,
+ * PC and opcode into that core's ring without taking a lock. A background
+ * thread drains the rings into folded stacks ("process;OPCODE[;state] cycles",
+ * the input of flamegraph.pl) and per-opcode totals. Cycles are estimated as
+ * samples * interval. The instruction set has no loops or calls, so a stack is
+ * only the process and its opcode.
+ */
+class Profiler {
+public:
+    enum Opcode { OP_VAR, OP_ADD, OP_PRINT, OP_MALLOC, OP_FREE, OP_SYSCALL, OP_OTHER, OPCODE_COUNT };
+    enum State { RUNNING, STALLED, KERNEL, STATE_COUNT };   // STALLED = delay, cache miss or wakeup wait
+
+    static const int MAX_CORES = 128;
+    static constexpr size_t RING_CAPACITY = 256;
+
+private:
+    typedef SpscRing<ProfileSample, RING_CAPACITY> Ring;
+
+    int interval;
+    Ring* rings;                            // One per core slot; the CPU thread is the only producer
+    std::atomic<long long> dropped;         // Samples lost to a full ring
+
+    // Aggregates (mutex); draining also happens under it, so there is one consumer
+    std::mutex mutex;
+    long long samples;
+    long long opcodeSamples[OPCODE_COUNT];
+    long long stateSamples[STATE_COUNT];
+    std::map<std::string, long long> folded;                    // Stack -> samples
+    std::map<std::pair<std::string, int>, long long> pcSamples; // (process, PC) -> samples
+
+    std::atomic<bool> running;
+    std::thread drainer;
+
+    static std::string frameName(const char* name) {
+        std::string frame(name);
+        std::replace(frame.begin(), frame.end(), ';', '_');
+        std::replace(frame.begin(), frame.end(), ' ', '_');
+        return frame;
+    }
+
+    // Move every queued sample into the aggregates (caller holds mutex)
+    void drainLocked() {
+        static const char* syscallNames[] = {"yield", "getpid", "sleep", "io"};
+        ProfileSample sample;
+        for (int slot = 0; slot < MAX_CORES; slot++) {
+            while (rings[slot].pop(sample)) {
+                samples++;
+                opcodeSamples[sample.opcode]++;
+                stateSamples[sample.state]++;
+
+                std::string process = frameName(sample.name);
+                std::string stack = process + ";" + opcodeName(sample.opcode);
+                if (sample.state == STALLED) {
+                    stack += ";[stall]";
+                } else if (sample.state == KERNEL) {
+                    bool known = sample.syscall >= 0 && sample.syscall < 4;
+                    stack += std::string(";[kernel:") + (known ? syscallNames[(int)sample.syscall] : "?") + "]";
+                }
+                folded[stack]++;
+                pcSamples[{process, sample.pc}]++;
+            }
+        }
+    }
+
+    // Share of all samples, to one decimal (caller holds mutex)
+    float percentOf(long long count) const {
+        return samples > 0 ? (float)(count * 1000 / samples) / 10.0f : 0.0f;
+    }
+
+    void drainLoop() {
+        while (running) {
+            drain();
+            std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        }
+    }
+
+public:
+    Profiler(int sampleInterval)
+        : interval(sampleInterval), rings(new Ring[MAX_CORES]), dropped(0), samples(0), running(true) {
+        for (auto& count : opcodeSamples) count = 0;
+        for (auto& count : stateSamples) count = 0;
+        drainer = std::thread(&Profiler::drainLoop, this);
+    }
+
+    ~Profiler() {
+        running = false;
+        if (drainer.joinable()) drainer.join();
+        delete[] rings;
+    }
+
+    Profiler(const Profiler&) = delete;
+    Profiler& operator=(const Profiler&) = delete;
+
+    int getInterval() const { return interval; }
+    bool due(int cycle) const { return cycle % interval == 0; }
+
+    static Opcode opcodeOf(const std::string& instruction) {
+        if (instruction.compare(0, 3, "VAR") == 0) return OP_VAR;
+        if (instruction.compare(0, 3, "ADD") == 0) return OP_ADD;
+        if (instruction.compare(0, 5, "PRINT") == 0) return OP_PRINT;
+        if (instruction.compare(0, 6, "MALLOC") == 0) return OP_MALLOC;
+        if (instruction.compare(0, 4, "FREE") == 0) return OP_FREE;
+        if (instruction.compare(0, 7, "SYSCALL") == 0) return OP_SYSCALL;
+        return OP_OTHER;
+    }
+
+    static const char* opcodeName(int opcode) {
+        static const char* names[] = {"VAR", "ADD", "PRINT", "MALLOC", "FREE", "SYSCALL", "OTHER"};
+        return opcode >= 0 && opcode < OPCODE_COUNT ? names[opcode] : "OTHER";
+    }
+
+    static void setName(ProfileSample& sample, const std::string& name) {
+        size_t length = std::min(name.size(), sizeof(sample.name) - 1);
+        std::memcpy(sample.name, name.data(), length);
+        sample.name[length] = '\0';
+    }
+
+    // Queue a sample from the core in 'slot' (CPU thread only)
+    void record(int slot, const ProfileSample& sample) {
+        if (!rings[slot % MAX_CORES].push(sample)) {
+            dropped.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+
+    void drain() {
+        std::lock_guard<std::mutex> lock(mutex);
+        drainLocked();
+    }
+
+    // Write folded stacks weighted by estimated cycles; false if the file cannot be opened
+    bool writeFolded(const std::string& path) {
+        std::ofstream file(path);
+        if (!file.is_open()) return false;
+        std::lock_guard<std::mutex> lock(mutex);
+        drainLocked();
+        for (const auto& stack : folded) {
+            file << stack.first << " " << stack.second * interval << "\n";
+        }
+        return true;
+    }
+
+    // Per-opcode cycle totals, run/stall/kernel split and the hottest PCs
+    void display(std::ostream& out, int hotCount = 10) {
+        std::lock_guard<std::mutex> lock(mutex);
+        drainLocked();
+
+        out << "Profile: " << samples << " samples every " << interval << " cycles (~"
+            << samples * interval << " busy core-cycles), " << dropped.load() << " dropped\n";
+        if (samples == 0) return;
+
+        out << "  Opcode     Samples   ~Cycles       %\n";
+        for (int op = 0; op < OPCODE_COUNT; op++) {
+            if (opcodeSamples[op] == 0) continue;
+            out << "  " << std::left << std::setw(8) << opcodeName(op) << std::right
+                << std::setw(10) << opcodeSamples[op]
+                << std::setw(10) << opcodeSamples[op] * interval
+                << std::setw(8) << percentOf(opcodeSamples[op]) << "\n";
+        }
+        out << "  Running " << percentOf(stateSamples[RUNNING]) << "%, stalled "
+            << percentOf(stateSamples[STALLED]) << "%, kernel "
+            << percentOf(stateSamples[KERNEL]) << "%\n";
+
+        std::vector<std::pair<long long, std::pair<std::string, int>>> hottest;
+        for (const auto& entry : pcSamples) {
+            hottest.push_back({entry.second, entry.first});
+        }
+        int shown = std::min(hotCount, (int)hottest.size());
+        std::partial_sort(hottest.begin(), hottest.begin() + shown, hottest.end(),
+                          [](const auto& a, const auto& b) { return a.first > b.first; });
+        out << "  Hottest PCs:\n";
+        for (int i = 0; i < shown; i++) {
+            out << "    " << hottest[i].second.first << " @" << hottest[i].second.second << ": "
+                << hottest[i].first << " samples\n";
+        }
+    }
+};
+
+#endif // PROFILER_H
@@ -2,19 +2,56 @@
 #define SCHEDULER_H
 
 #include <vector>
-#include <queue>
 #include <thread>
 #include <mutex>
 #include <atomic>
 #include <chrono>
+#include <ctime>
 #include <algorithm>
 #include <iomanip>
 #include <sstream>
 #include <cstdlib>
 #include <fstream>
+#include <random>
+#include <deque>
+#include <condition_variable>
+#include <map>
+#include <set>
+#include <tuple>
+#include <unordered_map>
+#include <climits>
 #include "Process.h"
+#include "ProcessList.h"
 #include "Config.h"
 #include "Memory.h"
+#include "Analytics.h"
+#include "CacheModel.h"
+#include "SlabAllocator.h"
+#include "Trace.h"
+#include "Profiler.h"
+
+// localtime() and ctime() share one static buffer; timestamps formatted on
+// several threads at once (batch log headers, Cluster nodes) must not use them
+inline std::tm localTimeOf(std::time_t t) {
+    std::tm local;
+#ifdef _WIN32
+    localtime_s(&local, &t);
+#else
+    localtime_r(&t, &local);
+#endif
+    return local;
+}
+
+// ctime() format without the trailing newline, e.g. "Sun Oct  4 09:05:01 2026"
+inline std::string ctimeString(std::time_t t) {
+    std::tm local = localTimeOf(t);
+    char date[16], time[16];
+    std::strftime(date, sizeof(date), "%a %b", &local);
+    std::strftime(time, sizeof(time), "%H:%M:%S %Y", &local);
+    std::ostringstream oss;
+    oss << date << " " << std::setw(2) << local.tm_mday << " " << time;
+    return oss.str();
+}
 
 // CPU Core - Represents a single CPU core
 class CPUCore {
@@ -24,21 +61,155 @@ private:
     bool isIdle;
     int executedCycles;
     int delayCyclesRemaining;  // For busy-waiting
+    Process* heldBy;           // Multi-core batch job occupying this core without running on it
+    
+    // Lifetime statistics
+    long long busyCycles;
+    long long idleCycles;
+    int idleStreak;            // Consecutive idle cycles up to now
+    
+    // Private data cache (off unless enableCache is called)
+    bool cacheEnabled;
+    CacheHierarchy cache;
+    std::string cacheFlush;    // What a context switch invalidates: "all", "l1" or "none"
+    int lastProcessID;         // Last process that ran here, to detect context switches
+    long long stallCycles;     // Cycles lost to cache misses
+    
+    // SMT throughput share: an instruction issues once the credit reaches 1
+    double smtSpeed;
+    double smtCredit;
+    long long smtStallCycles;  // Cycles lost to busy siblings
+    
+    // Idle states (C-states), deeper the longer the core stays idle
+    std::vector<int> cstateThresholds;
+    std::vector<int> cstateExitLatencies;
+    std::vector<long long> idleResidency;   // Idle cycles spent in C1, C2, ...
+    long long wakeups;                      // Dispatches that had to leave a C-state
+    long long wakeupPenaltyCycles;
+    
+    // Kernel mode after a SYSCALL; its scheduler effect waits until the cost is paid
+    int kernelCyclesRemaining;
+    int pendingSyscall;        // SYSCALL number whose effect is due, or -1
+    long long userCycles;
+    long long systemCycles;
 
 public:
-    CPUCore(int id) : coreID(id), currentProcess(nullptr), isIdle(true), executedCycles(0), delayCyclesRemaining(0) {}
+    CPUCore(int id) : coreID(id), currentProcess(nullptr), isIdle(true), executedCycles(0), delayCyclesRemaining(0), heldBy(nullptr),
+                      busyCycles(0), idleCycles(0), idleStreak(0), cacheEnabled(false), lastProcessID(-1), stallCycles(0),
+                      smtSpeed(1.0), smtCredit(0.0), smtStallCycles(0), wakeups(0), wakeupPenaltyCycles(0),
+                      kernelCyclesRemaining(0), pendingSyscall(-1), userCycles(0), systemCycles(0) {}
 
     bool idle() const { return isIdle; }
     int getID() const { return coreID; }
     Process* getProcess() const { return currentProcess; }
     int getExecutedCycles() const { return executedCycles; }
     int getDelayCyclesRemaining() const { return delayCyclesRemaining; }
+    Process* getHeldBy() const { return heldBy; }
+    long long getBusyCycles() const { return busyCycles; }
+    long long getIdleCycles() const { return idleCycles; }
+    int getIdleStreak() const { return idleStreak; }
+    bool hasCache() const { return cacheEnabled; }
+    const CacheHierarchy& getCache() const { return cache; }
+    long long getStallCycles() const { return stallCycles; }
+    long long getSmtStallCycles() const { return smtStallCycles; }
+
+    long long getUserCycles() const { return userCycles; }
+    long long getSystemCycles() const { return systemCycles; }
+    bool inKernel() const { return kernelCyclesRemaining > 0; }
+    int getPendingSyscall() const { return pendingSyscall; }
+
+    // Charge a SYSCALL's kernel cost; its effect is applied once the cost is paid
+    void enterKernel(int cycles, int syscall) {
+        kernelCyclesRemaining = cycles;
+        pendingSyscall = syscall;
+    }
+
+    // SYSCALL whose kernel cost is paid and whose effect is now due, or -1
+    int takeDueSyscall() {
+        if (pendingSyscall < 0 || kernelCyclesRemaining > 0) return -1;
+        int syscall = pendingSyscall;
+        pendingSyscall = -1;
+        return syscall;
+    }
+
+    const std::vector<long long>& getIdleResidency() const { return idleResidency; }
+    long long getWakeups() const { return wakeups; }
+    long long getWakeupPenaltyCycles() const { return wakeupPenaltyCycles; }
+
+    void enableIdleStates(const std::vector<int>& thresholds, const std::vector<int>& exitLatencies) {
+        cstateThresholds = thresholds;
+        cstateExitLatencies = exitLatencies;
+        idleResidency.assign(thresholds.size(), 0);
+    }
+
+    // 0 while running or shallow-idle, otherwise the C-state number reached
+    int getIdleState() const {
+        if (!isIdle) return 0;
+        int state = 0;
+        while (state < (int)cstateThresholds.size() && idleStreak >= cstateThresholds[state]) {
+            state++;
+        }
+        return state;
+    }
+
+    // Share of a full core this thread gets this cycle (set by the scheduler)
+    void setSmtSpeed(double speed) { smtSpeed = speed; }
+
+    void enableCache(const SystemConfig& cfg) {
+        bool plru = (cfg.cachePolicy == "plru");
+        cache.l1.configure(cfg.cacheL1Sets, cfg.cacheL1Ways, cfg.cacheLineSize, plru);
+        cache.l2.configure(cfg.cacheL2Sets, cfg.cacheL2Ways, cfg.cacheLineSize, plru);
+        cache.l2Latency = cfg.cacheL2Latency;
+        cache.memoryLatency = cfg.cacheMemoryLatency;
+        cacheFlush = cfg.cacheFlush;
+        cacheEnabled = true;
+    }
+
+    // Count this cycle as busy or idle
+    void accountCycle() {
+        if (isIdle) {
+            idleCycles++;
+            idleStreak++;
+            int state = getIdleState();
+            if (state > 0) idleResidency[state - 1]++;
+        } else {
+            busyCycles++;
+            idleStreak = 0;
+        }
+    }
+
+    // Reserve this core as an extra core of a multi-core job
+    void holdFor(Process* p) {
+        heldBy = p;
+        isIdle = false;
+    }
+
+    void releaseHold() {
+        heldBy = nullptr;
+        isIdle = (currentProcess == nullptr);
+    }
 
     void assignProcess(Process* p) {
+        int exitLatency = 0;
+        int state = getIdleState();
+        if (p && state > 0) {
+            exitLatency = cstateExitLatencies[state - 1];
+            wakeups++;
+            wakeupPenaltyCycles += exitLatency;
+        }
+        
         currentProcess = p;
         isIdle = false;
         executedCycles = 0;
         delayCyclesRemaining = 0;
+        smtCredit = 0.0;
+        delayCyclesRemaining = exitLatency;   // Waking up stalls like busy-waiting
+        kernelCyclesRemaining = 0;
+        pendingSyscall = -1;
+        if (p && cacheEnabled && p->getID() != lastProcessID) {
+            cache.flush(cacheFlush);
+            lastProcessID = p->getID();
+        }
         if (p) {
             p->setAssignedCore(coreID);
             p->setState(Process::RUNNING);
@@ -53,33 +224,138 @@ public:
         isIdle = true;
         executedCycles = 0;
         delayCyclesRemaining = 0;
+        kernelCyclesRemaining = 0;
+        pendingSyscall = -1;
     }
 
     // Execute one cycle (either busy-waiting or actual instruction)
-    void executeCycle(int delayPerExec) {
+    // Returns true if an instruction was executed
+    bool executeCycle(int delayPerExec) {
         if (currentProcess && !isIdle) {
+            currentProcess->countCpuCycle();
+            if (kernelCyclesRemaining > 0) {
+                // Kernel mode: system time, no instruction
+                kernelCyclesRemaining--;
+                systemCycles++;
+                currentProcess->countSystemCycle();
+                return false;
+            }
+            userCycles++;
             if (delayCyclesRemaining > 0) {
                 // Busy-waiting - process stays in CPU but doesn't execute instruction
                 delayCyclesRemaining--;
+            } else if ((smtCredit += smtSpeed) < 1.0) {
+                // Siblings took this cycle's issue slots
+                smtStallCycles++;
             } else {
+                smtCredit -= 1.0;
+                
+                // Touch the instruction's data; misses stall like busy-waiting
+                int stall = cacheEnabled ? accessData() : 0;
+                
                 // Execute the actual instruction
                 currentProcess->executeInstruction();
                 executedCycles++;
                 
                 // Set up delay cycles for next instruction (if any)
-                if (!currentProcess->isFinished() && delayPerExec > 0) {
-                    delayCyclesRemaining = delayPerExec;
+                if (!currentProcess->isFinished() && delayPerExec + stall > 0) {
+                    delayCyclesRemaining = delayPerExec + stall;
                 }
+                return true;
             }
         }
+        return false;
     }
 
     bool processFinished() const {
         return currentProcess && currentProcess->isFinished();
     }
+
+    // Run the current instruction's data through the cache, returning the stall
+    int accessData() {
+        uint64_t address;
+        int bytes;
+        if (!currentProcess->getDataAccess(address, bytes)) return 0;
+        long long accesses = cache.l1.getAccesses();
+        long long misses = cache.l1.getMisses();
+        int stall = cache.access(address, bytes);
+        currentProcess->countCacheAccesses((int)(cache.l1.getAccesses() - accesses),
+                                           (int)(cache.l1.getMisses() - misses));
+        stallCycles += stall;
+        return stall;
+    }
     
     bool isBusyWaiting() const {
-        return delayCyclesRemaining > 0;
+        return delayCyclesRemaining > 0 || kernelCyclesRemaining > 0;
+    }
+};
+
+// CoreStats - Lifetime counters of a core (kept after it is hot-removed)
+struct CoreStats {
+    int coreID;
+    long long busyCycles;
+    long long idleCycles;
+    bool online;
+    long long cacheAccesses;    // L1 lookups
+    long long l1Misses;
+    long long l2Misses;
+    long long stallCycles;
+    long long smtStallCycles;
+    std::vector<long long> idleResidency;   // Idle cycles per C-state
+    long long wakeups;
+    long long wakeupPenaltyCycles;
+    long long userCycles;
+    long long systemCycles;
+
+    static CoreStats of(const CPUCore* core, bool online) {
+        const CacheHierarchy& cache = core->getCache();
+        return {core->getID(), core->getBusyCycles(), core->getIdleCycles(), online,
+                cache.l1.getAccesses(), cache.l1.getMisses(), cache.l2.getMisses(), core->getStallCycles(),
+                core->getSmtStallCycles(), core->getIdleResidency(), core->getWakeups(),
+                core->getWakeupPenaltyCycles(), core->getUserCycles(), core->getSystemCycles()};
+    }
+
+    float getUtilization() const {
+        long long total = busyCycles + idleCycles;
+        return total > 0 ? (float)busyCycles / total * 100.0f : 0.0f;
+    }
+};
+
+// PhysicalCoreStats - Counters of one SMT physical core (its siblings combined)
+struct PhysicalCoreStats {
+    int physicalID;
+    long long busyCycles;       // At least one sibling running
+    long long idleCycles;
+    long long sharedCycles;     // Two or more siblings running
+
+    float getUtilization() const {
+        long long total = busyCycles + idleCycles;
+        return total > 0 ? (float)busyCycles / total * 100.0f : 0.0f;
+    }
+
+    float getSharedPercent() const {
+        return busyCycles > 0 ? (float)sharedCycles / busyCycles * 100.0f : 0.0f;
+    }
+};
+
+// DagRun - Progress of one DAG submitted through Scheduler::submitDag
+struct DagRun {
+    std::string source;             // File the DAG was loaded from
+    int processCount;
+    int completedCount;             // Finished or killed
+    int submitCycle;
+    int finishCycle;                // -1 while still running
+    long long criticalPathCycles;   // Lower bound on makespan with unlimited cores
+
+    int getMakespan(int currentCycle) const {
+        return (finishCycle >= 0 ? finishCycle : currentCycle) - submitCycle;
+    }
+
+    // How close the run came to its critical-path lower bound (100% = optimal)
+    float getCriticalPathUtilization(int currentCycle) const {
+        int makespan = getMakespan(currentCycle);
+        if (makespan <= 0) return 0.0f;
+        return (float)criticalPathCycles / makespan * 100.0f;
     }
 };
 
@@ -95,37 +371,158 @@ private:
     std::vector<CPUCore*> cpuCores;
     
     // Process Queues
-    std::queue<Process*> readyQueue;
-    std::vector<Process*> runningProcesses;
+    ProcessList readyQueue;
+    ProcessList suspendedProcesses;     // Guarded by queueMutex, like readyQueue
+    ProcessList blockedProcesses;       // DAG processes waiting on parents (queueMutex)
+    std::vector<DagRun> dagRuns;        // Guarded by queueMutex
+    ProcessList runningProcesses;       // Guarded by runningMutex
+    std::unordered_multimap<std::string, Process*> liveByName;  // Unfinished processes (queueMutex)
     std::vector<Process*> finishedProcesses;
     
     // Thread control
     std::atomic<bool> isRunning;
     std::atomic<bool> autoGenerateProcesses;
+    std::mutex coreMutex;       // Held by the execution loop for a whole cycle
     std::mutex queueMutex;
     std::mutex runningMutex;
     std::mutex finishedMutex;
+    // Lock order: coreMutex -> queueMutex -> runningMutex -> finishedMutex
+    
+    // Warm pool of ready-made processes filled by prefetchLoop
+    std::deque<Process*> warmPool;
+    std::mutex poolMutex;
+    std::condition_variable poolNotFull;
+    std::atomic<int> poolMisses;       // Arrivals that found the pool empty
+    
+    // EASY backfilling: running jobs keyed by estimated end cycle (coreMutex)
+    std::multimap<int, Process*> availabilityProfile;
+    // Ready jobs keyed by (cores, estimated cycles, ready-since cycle), so a
+    // backfill pass finds the ones that fit without scanning the queue (queueMutex)
+    typedef std::tuple<int, int, int, Process*> BackfillKey;
+    std::set<BackfillKey> backfillIndex;
+    std::atomic<int> backfilledCount;
+    
+    // Core hotplug and autoscaling (coreMutex)
+    int nextCoreID;
+    std::vector<CoreStats> retiredCores;
+    std::vector<int> recentReadyWaits;  // Ring of the last waits, in cycles
+    int recentReadyWaitsNext;
+    std::atomic<int> autoscaleAdds;
+    std::atomic<int> autoscaleRemoves;
+    int lastIntervalWaitP99;            // Wait p99 seen by the last autoscale decision
+    std::map<int, PhysicalCoreStats> physicalStats;  // By physical core ID (SMT only)
+    
+    // Real-time clock health (tickMutex)
+    std::mutex tickMutex;
+    LatencyHistogram tickOverruns;      // How late a cycle finished past its deadline
+    LatencyHistogram tickJitter;        // How late the loop woke up for a deadline
+    long long ticks;
+    long long skippedTicks;             // Deadlines dropped by the "skip" policy
+    long long burstTicks;               // Cycles run back-to-back by the "burst" policy
+    
+    // Online queueing statistics (coreMutex)
+    QueueAnalytics analytics;
+    std::atomic<int> arrivalsThisCycle;
     
     // Statistics
-    int totalProcessesCreated;
-    int currentCycle;
+    std::atomic<int> totalProcessesCreated;
+    std::atomic<int> nextProcessID;      // IDs are reserved up front, so batches need one atomic add
+    std::atomic<bool> logsDirectoryReady;
+    std::atomic<int> killedCount;
+    std::atomic<int> currentCycle;
     std::chrono::steady_clock::time_point startTime;
 
     // NEW: pointer to shared MemoryManager (non-owning)
     MemoryManager* memoryManager;
+    SlabAllocator* slabAllocator;             // Owned; used instead when process sizes are discrete
+    Profiler* profiler;                       // Owned; null unless profile-interval is set
+    std::atomic<long long> committedMemory;   // Bytes requested by admitted, live processes
+    
+    // Memory backend activity, kept by allocateProcessMemory/releaseProcessMemory (vmMutex)
+    std::mutex vmMutex;
+    long long allocSuccesses;
+    long long allocFailures;
+    long long memoryFrees;
+    int residentProcesses;
+    LatencyHistogram allocLatency;      // ns
+    LatencyHistogram freeLatency;       // ns
+    
+    // System calls (coreMutex, except sleepers under queueMutex)
+    std::multimap<int, Process*> sleepers;     // Wake cycle -> sleeping or IO-blocked process
+    long long syscallCounts[4];                 // By SYSCALL number
+    long long blockedSyscallCycles;             // Cycles requested by sleep and IO
+    
+    // In-process heap activity (coreMutex)
+    long long heapMallocs;
+    long long heapFrees;
+    long long heapGrowths;
+    long long heapGrowthFailures;
+    long long heapRegionsLost;          // Old region could not be restored after a refused growth
+    LatencyHistogram heapLatency;       // ns per MALLOC/FREE, growth excluded
+    std::atomic<int> migratedOut;
+    std::string processNamePrefix;      // Generated names are prefix + ID (set before starting)
+    
+    // Time spent blocked on coreMutex/queueMutex on the hot paths (see lockTimed)
+    std::atomic<long long> lockWaitNanos;
+    std::atomic<long long> lockContentions;
 
 public:
     Scheduler(const SystemConfig& cfg, MemoryManager* memMgr) 
         : config(cfg),
           isRunning(false),
           autoGenerateProcesses(false),
+          poolMisses(0),
+          backfilledCount(0),
+          nextCoreID(0),
+          recentReadyWaitsNext(0),
+          autoscaleAdds(0),
+          autoscaleRemoves(0),
+          lastIntervalWaitP99(0),
+          ticks(0),
+          skippedTicks(0),
+          burstTicks(0),
+          arrivalsThisCycle(0),
           totalProcessesCreated(0),
+          nextProcessID(0),
+          logsDirectoryReady(false),
+          killedCount(0),
           currentCycle(0),
-          memoryManager(memMgr) {
+          memoryManager(memMgr),
+          slabAllocator(nullptr),
+          profiler(nullptr),
+          committedMemory(0),
+          allocSuccesses(0),
+          allocFailures(0),
+          memoryFrees(0),
+          residentProcesses(0),
+          blockedSyscallCycles(0),
+          heapMallocs(0),
+          heapFrees(0),
+          heapGrowths(0),
+          heapGrowthFailures(0),
+          heapRegionsLost(0),
+          migratedOut(0),
+          processNamePrefix("Process_"),
+          lockWaitNanos(0),
+          lockContentions(0) {
+        
+        for (auto& count : syscallCounts) count = 0;
         
         // Create CPU cores
-        for (int i = 0; i < config.numCPUs; i++) {
-            cpuCores.push_back(new CPUCore(i));
+        addCoresLocked(config.numCPUs);
+        
+        // Discrete process sizes are served by size-class slabs instead of a general fit search:
+        // always when mem-size-classes is set, and for a fixed size only if no MemoryManager was given
+        if (!config.memSizeClasses.empty()) {
+            slabAllocator = new SlabAllocator(std::vector<size_t>(config.memSizeClasses.begin(),
+                                                                  config.memSizeClasses.end()),
+                                              config.maxOverallMem);
+        } else if (!memoryManager && config.minMemPerProc == config.maxMemPerProc) {
+            slabAllocator = new SlabAllocator({config.minMemPerProc}, config.maxOverallMem);
+        }
+        
+        if (config.profileInterval > 0) {
+            profiler = new Profiler(config.profileInterval);
         }
     }
 
@@ -135,19 +532,324 @@ public:
             delete core;
         }
         // Clean up processes
-        for (auto p : runningProcesses) delete p;
+        while (!runningProcesses.empty()) {
+            delete runningProcesses.popFront();
+        }
         for (auto p : finishedProcesses) delete p;
         while (!readyQueue.empty()) {
-            delete readyQueue.front();
-            readyQueue.pop();
+            delete readyQueue.popFront();
+        }
+        while (!suspendedProcesses.empty()) {
+            delete suspendedProcesses.popFront();
+        }
+        while (!blockedProcesses.empty()) {
+            delete blockedProcesses.popFront();
         }
+        for (auto p : warmPool) delete p;
+        delete slabAllocator;
+        delete profiler;
         // memoryManager is owned by MainMenu, do not delete here
     }
 
     // Add a process to the ready queue
     void addProcess(Process* process) {
-        std::lock_guard<std::mutex> lock(queueMutex);
-        readyQueue.push(process);
+        process->setArrivalCycle(currentCycle);
+        TRACE_PROBE3(arrive, process->getID(), -1, process->getArrivalCycle());
+        arrivalsThisCycle++;
+        {
+            auto lock = lockTimed(queueMutex);
+            indexProcess(process);
+            enqueueReady(process);
+        }
+        totalProcessesCreated++;
+    }
+
+    // Add a batch of processes to the ready queue under a single lock acquisition
+    void addProcesses(const std::vector<Process*>& batch) {
+        int cycle = currentCycle;
+        for (auto p : batch) {
+            p->setArrivalCycle(cycle);
+            TRACE_PROBE3(arrive, p->getID(), -1, cycle);
+        }
+        arrivalsThisCycle += (int)batch.size();
+        {
+            auto lock = lockTimed(queueMutex);
+            for (auto p : batch) {
+                indexProcess(p);
+                enqueueReady(p);
+            }
+        }
+        totalProcessesCreated += (int)batch.size();
+    }
+
+    // Reserve a contiguous block of process IDs, returns the first one
+    int reserveProcessIDs(int count) {
+        return nextProcessID.fetch_add(count);
+    }
+
+    // Create 'count' processes named <prefix>_<id> and enqueue them as one batch.
+    // Programs and log files are built in parallel, then each is admitted like
+    // admitProcess; returns the number admitted (the rest did not fit in memory).
+    int submitProcessBatch(int count, const std::string& prefix) {
+        if (count <= 0) return 0;
+
+        int firstID = reserveProcessIDs(count);
+        std::string arrival = getCurrentTimeString();
+        ensureLogsDirectory();
+
+        std::vector<Process*> batch(count, nullptr);
+
+        int workerCount = (int)std::thread::hardware_concurrency();
+        if (workerCount < 1) workerCount = 1;
+        workerCount = std::min(workerCount, (count + 255) / 256);
+
+        // Seed each worker from the shared generator so runs still follow srand()
+        std::vector<unsigned int> seeds;
+        for (int w = 0; w < workerCount; w++) {
+            seeds.push_back((unsigned int)rand());
+        }
+
+        auto buildRange = [&](int worker, int begin, int end) {
+            std::mt19937 rng(seeds[worker]);
+            for (int i = begin; i < end; i++) {
+                int id = firstID + i;
+                batch[i] = buildProcess(prefix + "_" + std::to_string(id), id, arrival, rng);
+                batch[i]->setMemoryRequired(drawMemorySize(rng));
+            }
+        };
+
+        std::vector<std::thread> workers;
+        int chunk = (count + workerCount - 1) / workerCount;
+        for (int w = 1; w < workerCount; w++) {
+            int begin = std::min(count, w * chunk);
+            int end = std::min(count, begin + chunk);
+            workers.emplace_back(buildRange, w, begin, end);
+        }
+        buildRange(0, 0, std::min(count, chunk));
+        for (auto& t : workers) {
+            t.join();
+        }
+
+        return admitProcesses(batch);
+    }
+
+    // Submit a DAG of dependent processes from a file. Each line is
+    //   <name> <instructions> [parent ...]
+    // and parents must be declared on an earlier line, so the file is its
+    // own topological order. Returns the number of processes, or -1 on error.
+    int submitDag(const std::string& filename) {
+        std::ifstream file(filename);
+        if (!file.is_open()) {
+            std::cerr << "ERROR: Could not open DAG file '" << filename << "'\n";
+            return -1;
+        }
+        
+        std::vector<Process*> nodes;
+        std::map<std::string, Process*> byName;
+        std::mt19937 rng((unsigned int)rand());
+        ensureLogsDirectory();
+        
+        auto discard = [&]() {
+            for (auto p : nodes) delete p;
+            return -1;
+        };
+        
+        std::string line;
+        int lineNumber = 0;
+        while (std::getline(file, line)) {
+            lineNumber++;
+            if (line.empty() || line[0] == '#') continue;
+            
+            std::istringstream iss(line);
+            std::string name;
+            int instructions = 0;
+            if (!(iss >> name)) continue;
+            if (!(iss >> instructions) || instructions < 1) {
+                std::cerr << "ERROR: " << filename << ":" << lineNumber
+                          << ": expected '<name> <instructions> [parent ...]'\n";
+                return discard();
+            }
+            if (byName.count(name)) {
+                std::cerr << "ERROR: " << filename << ":" << lineNumber
+                          << ": duplicate process '" << name << "'\n";
+                return discard();
+            }
+            
+            Process* p = buildProcess(name, reserveProcessIDs(1), "DAG", instructions, rng);
+            nodes.push_back(p);
+            byName[name] = p;
+            
+            std::string parentName;
+            while (iss >> parentName) {
+                auto it = byName.find(parentName);
+                if (it == byName.end() || it->second == p) {
+                    std::cerr << "ERROR: " << filename << ":" << lineNumber
+                              << ": unknown parent '" << parentName
+                              << "' (parents must be declared first)\n";
+                    return discard();
+                }
+                p->addParent(it->second);
+            }
+        }
+        
+        if (nodes.empty()) {
+            std::cerr << "ERROR: DAG file '" << filename << "' has no processes\n";
+            return -1;
+        }
+        
+        // Longest path to a sink, walking the topological order backwards
+        long long longestPath = 0;
+        for (int i = (int)nodes.size() - 1; i >= 0; i--) {
+            long long longestChild = 0;
+            for (auto child : nodes[i]->getDependents()) {
+                longestChild = std::max(longestChild, child->getCriticalPathLength());
+            }
+            nodes[i]->setCriticalPathLength(nodes[i]->getTotalInstructions() + longestChild);
+            longestPath = std::max(longestPath, nodes[i]->getCriticalPathLength());
+        }
+        
+        int cycle = currentCycle;
+        {
+            std::lock_guard<std::mutex> lock(queueMutex);
+            
+            DagRun run;
+            run.source = filename;
+            run.processCount = (int)nodes.size();
+            run.completedCount = 0;
+            run.submitCycle = cycle;
+            run.finishCycle = -1;
+            run.criticalPathCycles = longestPath * (config.delayPerExec + 1);
+            dagRuns.push_back(run);
+            
+            for (auto p : nodes) {
+                p->setDagRunIndex((int)dagRuns.size() - 1);
+                p->setArrivalCycle(cycle);
+                indexProcess(p);
+                if (p->getUnfinishedParents() == 0) {
+                    enqueueReady(p);
+                } else {
+                    p->setState(Process::WAITING);
+                    blockedProcesses.pushBack(p);
+                }
+            }
+        }
+        totalProcessesCreated += (int)nodes.size();
+        arrivalsThisCycle += (int)nodes.size();
+        return (int)nodes.size();
+    }
+
+    // Submit a batch job that needs 'cores' cores and declares an estimated
+    // length (for the backfill scheduler). Returns false if it can never fit.
+    bool submitBatchJob(const std::string& name, int cores, int estimate, int instructions) {
+        if (cores < 1 || cores > getCoreCount() || estimate < 1 || instructions < 1) {
+            return false;
+        }
+        
+        std::mt19937 rng((unsigned int)rand());
+        ensureLogsDirectory();
+        Process* p = buildProcess(name, reserveProcessIDs(1), "Batch", instructions, rng);
+        p->setRequiredCores(cores);
+        p->setEstimatedInstructions(estimate);
+        
+        // Cores may have been removed meanwhile; hold coreMutex so none go until it is queued
+        std::lock_guard<std::mutex> coreLock(coreMutex);
+        if (cores > (int)cpuCores.size()) {
+            delete p;
+            return false;
+        }
+        addProcess(p);
+        return true;
+    }
+
+    // Snapshot of submitted DAGs (for report)
+    std::vector<DagRun> getDagRuns() const {
+        std::lock_guard<std::mutex> lock(const_cast<std::mutex&>(queueMutex));
+        return dagRuns;
+    }
+
+    // Allocate a process's memory and put it on the ready queue.
+    // Returns false if the MemoryManager cannot fit it.
+    bool admitProcess(Process* p) {
+        if (!reserveProcessMemory(p)) {
+            return false;
+        }
+        addProcess(p);
+        return true;
+    }
+
+    // admitProcess for a batch, enqueued under one lock acquisition. Processes
+    // whose memory does not fit are deleted; returns how many were admitted.
+    int admitProcesses(const std::vector<Process*>& batch) {
+        std::vector<Process*> admitted;
+        admitted.reserve(batch.size());
+        for (auto p : batch) {
+            if (reserveProcessMemory(p)) {
+                admitted.push_back(p);
+            } else {
+                delete p;
+            }
+        }
+        addProcesses(admitted);
+        return (int)admitted.size();
+    }
+
+    // Hand over a ready process for migration to another node, releasing its
+    // memory here. DAG members and multi-core jobs stay put. nullptr if none.
+    Process* takeMigrationCandidate() {
+        Process* p = nullptr;
+        {
+            std::lock_guard<std::mutex> lock(queueMutex);
+            for (p = readyQueue.back(); p; p = readyQueue.prevOf(p)) {
+                if (p->getDagRunIndex() < 0 && p->getRequiredCores() == 1) break;
+            }
+            if (!p) return nullptr;
+            removeReady(p);
+            unindexProcess(p);
+        }
+        releaseProcessMemory(p);
+        totalProcessesCreated--;
+        migratedOut++;
+        return p;
+    }
+
+    // Build an auto-style process (program, log header, memory request) with an
+    // ID chosen by the caller, e.g. a cluster-wide generator
+    Process* createGeneratedProcess(int id, std::mt19937& rng) {
+        return createGeneratedProcess(id, drawMemorySize(rng), rng);
+    }
+
+    // Same, with a memory request the caller already drew
+    Process* createGeneratedProcess(int id, size_t memory, std::mt19937& rng) {
+        ensureLogsDirectory();
+        Process* p = buildProcess(processNamePrefix + std::to_string(id), id, "", rng);
+        p->setMemoryRequired(memory);
+        return p;
+    }
+
+    // Name generated processes prefix + ID, so several schedulers sharing the
+    // logs directory do not overwrite each other's logs (call before starting)
+    void setProcessNamePrefix(const std::string& prefix) {
+        processNamePrefix = prefix;
+    }
+
+    // A process memory size from the configured classes or range
+    size_t drawMemorySize(std::mt19937& rng) const {
+        if (!config.memSizeClasses.empty()) {
+            std::uniform_int_distribution<size_t> classDist(0, config.memSizeClasses.size() - 1);
+            return config.memSizeClasses[classDist(rng)];
+        }
+        if (config.maxMemPerProc > config.minMemPerProc) {
+            std::uniform_int_distribution<size_t> memDist(config.minMemPerProc, config.maxMemPerProc);
+            return memDist(rng);
+        }
+        return config.minMemPerProc;
+    }
+
+    // Run one simulated cycle from an external driver (e.g. a Cluster node
+    // thread) instead of the scheduler's own real-time loop
+    void stepCycle() {
+        auto coreLock = lockTimed(coreMutex);
+        runCycle();
     }
 
     // Start the scheduler
@@ -165,32 +867,239 @@ public:
     // Stop the scheduler
     void stop() {
         isRunning = false;
-        autoGenerateProcesses = false;
+        stopProcessGeneration();
     }
 
     // Start automatic process generation
     void startProcessGeneration() {
         if (!autoGenerateProcesses) {
             autoGenerateProcesses = true;
+            if (config.prefetchPoolSize > 0) {
+                std::thread prefetchThread(&Scheduler::prefetchLoop, this);
+                prefetchThread.detach();
+            }
             std::thread genThread(&Scheduler::processGenerationLoop, this);
             genThread.detach();
         }
     }
 
-    // Stop automatic process generation
+    // Stop automatic process generation (the warm pool is kept for a restart)
     void stopProcessGeneration() {
         autoGenerateProcesses = false;
+        std::lock_guard<std::mutex> lock(poolMutex);
+        poolNotFull.notify_all();
     }
 
     // Get statistics
     int getTotalProcesses() const { return totalProcessesCreated; }
-    int getReadyQueueSize() const { return (int)readyQueue.size(); }
-    int getRunningCount() const { return (int)runningProcesses.size(); }
-    int getFinishedCount() const { return (int)finishedProcesses.size(); }
+    int getReadyQueueSize() const {
+        std::lock_guard<std::mutex> lock(const_cast<std::mutex&>(queueMutex));
+        return readyQueue.size();
+    }
+    // Processes waiting on DAG parents (sleepers share the blocked list)
+    int getBlockedCount() const {
+        std::lock_guard<std::mutex> lock(const_cast<std::mutex&>(queueMutex));
+        return blockedProcesses.size() - (int)sleepers.size();
+    }
+    // Processes asleep or waiting on I/O after a system call
+    int getSleepingCount() const {
+        std::lock_guard<std::mutex> lock(const_cast<std::mutex&>(queueMutex));
+        return (int)sleepers.size();
+    }
+    int getSuspendedCount() const {
+        std::lock_guard<std::mutex> lock(const_cast<std::mutex&>(queueMutex));
+        return suspendedProcesses.size();
+    }
+    int getKilledCount() const { return killedCount; }
+    int getWarmPoolSize() const {
+        std::lock_guard<std::mutex> lock(const_cast<std::mutex&>(poolMutex));
+        return (int)warmPool.size();
+    }
+    int getPoolMisses() const { return poolMisses; }
+    int getRunningCount() const {
+        std::lock_guard<std::mutex> lock(const_cast<std::mutex&>(runningMutex));
+        return runningProcesses.size();
+    }
+    int getFinishedCount() const {
+        std::lock_guard<std::mutex> lock(const_cast<std::mutex&>(finishedMutex));
+        return (int)finishedProcesses.size();
+    }
     int getCurrentCycle() const { return currentCycle; }
+    int getCoreCount() const {
+        std::lock_guard<std::mutex> lock(const_cast<std::mutex&>(coreMutex));
+        return (int)cpuCores.size();
+    }
+
+    // Hot-add cores while the simulation runs; returns how many were added
+    int addCores(int count) {
+        std::lock_guard<std::mutex> lock(coreMutex);
+        return addCoresLocked(count);
+    }
+
+    // Hot-remove cores, draining their processes back to the ready queue;
+    // returns how many were removed (at least one core always stays, and
+    // never fewer than the largest live multi-core job needs)
+    int removeCores(int count) {
+        std::lock_guard<std::mutex> lock(coreMutex);
+        return removeCoresLocked(count);
+    }
+
+    // Write arrival/service rates, utilization and the M/G/c prediction
+    void writeQueueingReport(std::ostream& out) const {
+        QueueAnalytics snapshot;
+        {
+            std::lock_guard<std::mutex> lock(const_cast<std::mutex&>(coreMutex));
+            snapshot = analytics;
+        }
+        snapshot.display(out);
+    }
+
+    bool usesSlabAllocator() const { return slabAllocator != nullptr; }
+    bool hasProfiler() const { return profiler != nullptr; }
+
+    // Write the profile as folded stacks and print the per-opcode summary
+    bool dumpProfile(const std::string& path, std::ostream& out) {
+        if (!profiler) return false;
+        if (!profiler->writeFolded(path)) {
+            out << "ERROR: Cannot write profile to '" << path << "'\n";
+            return false;
+        }
+        profiler->display(out);
+        out << "Folded stacks written to " << path << " (flamegraph.pl " << path << " > profile.svg)\n";
+        return true;
+    }
+
+    // Write memory usage, fragmentation and allocator activity (vmstat)
+    void writeVmStats(std::ostream& out) {
+        long long total = slabAllocator ? (long long)slabAllocator->getCapacity() : (long long)config.maxOverallMem;
+        long long used = slabAllocator ? (long long)slabAllocator->getOccupiedMemory() : committedMemory.load();
+        long long freeBytes = std::max(0LL, total - used);
+        
+        out << "Memory (" << (slabAllocator ? "slab" : memoryManager ? "MemoryManager" : "no backend") << "):\n";
+        out << "  Total: " << total << " B  Used: " << used << " B  Free: " << freeBytes << " B\n";
+        if (slabAllocator) {
+            // The slab backend knows its layout; MemoryManager only reports pass/fail
+            long long largest = std::min((long long)slabAllocator->getLargestFreeBlock(), freeBytes);
+            out << "  Largest free block: " << largest << " B  External fragmentation: "
+                << (freeBytes > 0 ? 1.0 - (double)largest / freeBytes : 0.0) << "\n";
+        } else {
+            out << "  Largest free block: n/a  External fragmentation: n/a (not exposed by MemoryManager)\n";
+        }
+        
+        std::lock_guard<std::mutex> lock(vmMutex);
+        out << "  Allocations: " << allocSuccesses << " ok, " << allocFailures << " failed  Frees: "
+            << memoryFrees << "\n";
+        out << "  Processes: " << residentProcesses << " resident, swapped n/a (no paging model)\n";
+        out << "  Page-in/page-out rate: n/a (no paging model)\n";
+        allocLatency.display(out, "Allocate latency", "ns");
+        freeLatency.display(out, "Free latency", "ns");
+    }
+
+    // Write SYSCALL counts and the user/system split (only once a SYSCALL ran)
+    void writeSyscallReport(std::ostream& out) {
+        std::lock_guard<std::mutex> lock(coreMutex);
+        long long total = 0;
+        for (long long count : syscallCounts) total += count;
+        if (total == 0) return;
+        
+        long long user = 0, system = 0;
+        for (auto core : cpuCores) {
+            user += core->getUserCycles();
+            system += core->getSystemCycles();
+        }
+        for (const auto& core : retiredCores) {
+            user += core.userCycles;
+            system += core.systemCycles;
+        }
+        out << "System calls: " << total << "  (yield " << syscallCounts[Process::SYS_YIELD]
+            << ", getpid " << syscallCounts[Process::SYS_GETPID] << ", sleep " << syscallCounts[Process::SYS_SLEEP]
+            << ", io " << syscallCounts[Process::SYS_IO] << ")\n";
+        out << "  CPU time: user " << user << " cycles, system " << system << " cycles";
+        if (user + system > 0) {
+            out << " (" << (double)system / (user + system) * 100.0 << "% system)";
+        }
+        out << "\n  Blocked in sleep/IO: " << blockedSyscallCycles << " cycles requested\n\n";
+    }
+
+    // Write MALLOC/FREE totals and latency (only once a heap was used)
+    void writeHeapReport(std::ostream& out) {
+        std::lock_guard<std::mutex> lock(coreMutex);
+        if (heapLatency.count == 0) return;
+        out << "Process heaps:\n";
+        out << "  MALLOC: " << heapMallocs << "  FREE: " << heapFrees << "  Region growths: "
+            << heapGrowths << " (" << heapGrowthFailures << " refused, " << heapRegionsLost << " lost)\n";
+        heapLatency.display(out, "MALLOC/FREE latency", "ns");
+        out << "\n";
+    }
+
+    // Write slab occupancy (only when the slab backend is in use)
+    void writeSlabReport(std::ostream& out) {
+        if (slabAllocator) {
+            slabAllocator->display(out);
+        }
+    }
+
+    // Write tick overrun and wake-up jitter statistics
+    void writeTickReport(std::ostream& out) {
+        std::lock_guard<std::mutex> lock(tickMutex);
+        out << "Real-time clock (" << config.cycleMs << " ms/cycle, policy " << config.tickPolicy << "):\n";
+        out << "  Ticks: " << ticks << "  Overruns: " << tickOverruns.count;
+        if (ticks > 0) {
+            out << " (" << (double)tickOverruns.count / ticks * 100.0 << "%)";
+        }
+        out << "  Skipped: " << skippedTicks << "  Burst cycles: " << burstTicks << "\n";
+        tickOverruns.display(out, "Overrun");
+        tickJitter.display(out, "Wake-up jitter");
+    }
+
+    // Per-core counters for online and removed cores (for report)
+    std::vector<CoreStats> getCoreStats() const {
+        std::lock_guard<std::mutex> lock(const_cast<std::mutex&>(coreMutex));
+        std::vector<CoreStats> stats = retiredCores;
+        for (auto core : cpuCores) {
+            stats.push_back(CoreStats::of(core, true));
+        }
+        std::sort(stats.begin(), stats.end(),
+                  [](const CoreStats& a, const CoreStats& b) { return a.coreID < b.coreID; });
+        return stats;
+    }
+
+    // Per-physical-core counters; empty unless SMT is on
+    std::vector<PhysicalCoreStats> getPhysicalCoreStats() const {
+        std::lock_guard<std::mutex> lock(const_cast<std::mutex&>(coreMutex));
+        std::vector<PhysicalCoreStats> stats;
+        for (const auto& entry : physicalStats) {
+            stats.push_back(entry.second);
+        }
+        return stats;
+    }
+
+    // 99th percentile of recent ready-queue waits, in cycles
+    int getReadyWaitP99() const {
+        std::lock_guard<std::mutex> lock(const_cast<std::mutex&>(coreMutex));
+        // With autoscaling the window is reset every interval, so report the last full one
+        return config.autoscale ? lastIntervalWaitP99 : readyWaitP99();
+    }
+    int getBackfilledCount() const { return backfilledCount; }
+    long long getCommittedMemory() const { return committedMemory; }
+    // Which backend admission allocates from
+    std::string getMemoryBackendName() const {
+        if (slabAllocator) return "slab";
+        if (memoryManager) return "MemoryManager";
+        return "none (committed memory only)";
+    }
+    int getMigratedOut() const { return migratedOut; }
+    long long getLockWaitNanos() const { return lockWaitNanos; }
+    long long getLockContentions() const { return lockContentions; }
+
+    // Processes queued or running here (for load balancing)
+    int getLoad() const {
+        return getReadyQueueSize() + getRunningCount();
+    }
 
     // Calculate CPU utilization
     float getCPUUtilization() const {
+        std::lock_guard<std::mutex> lock(const_cast<std::mutex&>(coreMutex));
         int busyCores = 0;
         for (auto core : cpuCores) {
             if (!core->idle()) busyCores++;
@@ -209,31 +1118,47 @@ public:
             if (runningProcesses.empty()) {
                 std::cout << "  (None)\n";
             } else {
-                for (auto p : runningProcesses) {
+                runningProcesses.forEach([](Process* p) {
                     std::cout << "  ";
                     p->displayCompact();
-                }
+                });
             }
         }
         std::cout << "\n";
 
         // Ready queue
-        std::cout << "Ready Queue (Size: " << readyQueue.size() << "):\n";
         {
             std::lock_guard<std::mutex> lock(queueMutex);
+            std::cout << "Ready Queue (Size: " << readyQueue.size() << "):\n";
             if (readyQueue.empty()) {
                 std::cout << "  (Empty)\n";
             } else {
-                // Can't iterate queue directly, so just show count
                 std::cout << "  " << readyQueue.size() << " processes waiting\n";
             }
+            
+            int sleeping = (int)sleepers.size();
+            int dagBlocked = blockedProcesses.size() - sleeping;
+            if (dagBlocked > 0) {
+                std::cout << "  " << dagBlocked << " processes blocked on DAG parents\n";
+            }
+            if (sleeping > 0) {
+                std::cout << "  " << sleeping << " processes sleeping/waiting on I/O\n";
+            }
+            
+            if (!suspendedProcesses.empty()) {
+                std::cout << "\nSuspended Processes:\n";
+                suspendedProcesses.forEach([](Process* p) {
+                    std::cout << "  ";
+                    p->displayCompact();
+                });
+            }
         }
         std::cout << "\n";
 
         // Finished processes
-        std::cout << "Finished Processes (Total: " << finishedProcesses.size() << "):\n";
         {
             std::lock_guard<std::mutex> lock(finishedMutex);
+            std::cout << "Finished Processes (Total: " << finishedProcesses.size() << "):\n";
             if (finishedProcesses.empty()) {
                 std::cout << "  (None)\n";
             } else {
@@ -257,25 +1182,53 @@ public:
         
         std::cout << "\n========== UTILIZATION REPORT ==========\n";
         std::cout << "CPU Utilization: " << getCPUUtilization() << "%\n";
-        std::cout << "Cores Used: " << countActiveCores() << "/" << config.numCPUs << "\n";
+        std::cout << "Cores Used: " << countActiveCores() << "/" << getCoreCount() << "\n";
+        std::cout << "Ready Wait p99: " << getReadyWaitP99() << " cycles\n";
+        if (config.autoscale) {
+            std::cout << "Autoscale: +" << autoscaleAdds << " / -" << autoscaleRemoves << " cores\n";
+        }
         std::cout << "Running Time: " << elapsed << " seconds\n";
         std::cout << "Current Cycle: " << currentCycle << "\n";
         std::cout << "\nProcess Statistics:\n";
         std::cout << "  Total Created: " << totalProcessesCreated << "\n";
         std::cout << "  Currently Running: " << getRunningCount() << "\n";
         std::cout << "  In Ready Queue: " << getReadyQueueSize() << "\n";
+        std::cout << "  Blocked on DAG Parents: " << getBlockedCount() << "\n";
+        std::cout << "  Sleeping/Waiting on I/O: " << getSleepingCount() << "\n";
+        std::cout << "  Suspended: " << getSuspendedCount() << "\n";
         std::cout << "  Finished: " << getFinishedCount() << "\n";
+        std::cout << "\n";
+        writeQueueingReport(std::cout);
+        std::cout << "\n";
+        writeTickReport(std::cout);
+        std::cout << "  Killed: " << getKilledCount() << "\n";
+        if (config.schedulerType == "backfill") {
+            std::cout << "  Backfilled: " << getBackfilledCount() << "\n";
+        }
+        std::cout << "  Warm Pool: " << getWarmPoolSize() << "/" << config.prefetchPoolSize
+                  << " (misses: " << getPoolMisses() << ")\n";
+        
+        auto runs = getDagRuns();
+        if (!runs.empty()) {
+            std::cout << "\nDAG Runs:\n";
+            for (const auto& run : runs) {
+                std::cout << "  " << run.source << ": " << run.completedCount << "/" << run.processCount
+                          << " done | Makespan: " << run.getMakespan(currentCycle) << " cycles"
+                          << " | Critical Path: " << run.criticalPathCycles << " cycles"
+                          << " | CP Utilization: " << run.getCriticalPathUtilization(currentCycle) << "%"
+                          << (run.finishCycle < 0 ? " (running)" : "") << "\n";
+            }
+        }
         std::cout << "========================================\n\n";
     }
 
     // Find process by name
     Process* findProcess(const std::string& name) {
-        // Check running processes
+        // Check live processes (running, ready, suspended, blocked)
         {
-            std::lock_guard<std::mutex> lock(runningMutex);
-            for (auto p : runningProcesses) {
-                if (p->getName() == name) return p;
-            }
+            std::lock_guard<std::mutex> lock(queueMutex);
+            Process* p = findLive(name, [](const Process*) { return true; });
+            if (p) return p;
         }
         
         // Check finished processes
@@ -289,6 +1242,65 @@ public:
         return nullptr;
     }
 
+    // Kill a ready, running or suspended process and release its memory immediately.
+    // DAG dependents that can no longer start are killed with it.
+    // Returns how many processes were killed (0 if no live process has that name).
+    int killProcess(const std::string& name) {
+        std::lock_guard<std::mutex> coreLock(coreMutex);
+        std::lock_guard<std::mutex> lock(queueMutex);
+        
+        Process* p = findLive(name, [](const Process*) { return true; });
+        if (!p) return 0;
+        if (blockedProcesses.remove(p)) {
+            removeSleeper(p);
+        } else if (!removeReady(p) && !suspendedProcesses.remove(p)) {
+            detachFromCores(p, findCoreRunning(p));
+        }
+        unindexProcess(p);
+        
+        // Detach from the DAG: parents forget it, dependents can never start
+        for (auto parent : p->getParents()) {
+            parent->removeDependent(p);
+        }
+        int cancelled = cancelDependents(p);
+        retireFromDag(p);
+        
+        releaseProcessMemory(p);
+        delete p;
+        killedCount++;
+        return 1 + cancelled;
+    }
+
+    // Pause a ready or running process until it is resumed
+    bool suspendProcess(const std::string& name) {
+        std::lock_guard<std::mutex> coreLock(coreMutex);
+        std::lock_guard<std::mutex> lock(queueMutex);
+        
+        Process* p = findLive(name, [this](const Process* q) {
+            return readyQueue.contains(q) || q->getState() == Process::RUNNING;
+        });
+        if (!p) return false;
+        if (!removeReady(p)) {
+            detachFromCores(p, findCoreRunning(p));
+        }
+        
+        p->setState(Process::SUSPENDED);
+        suspendedProcesses.pushBack(p);
+        return true;
+    }
+
+    // Put a suspended process back at the tail of the ready queue
+    bool resumeProcess(const std::string& name) {
+        std::lock_guard<std::mutex> lock(queueMutex);
+        
+        Process* p = findLive(name, [this](const Process* q) { return suspendedProcesses.contains(q); });
+        if (!p) return false;
+        
+        suspendedProcesses.remove(p);
+        enqueueReady(p);
+        return true;
+    }
+
     // Public method to initialize process log (for manually created processes)
     void initializeProcessLogPublic(Process* process) {
         initializeProcessLog(process);
@@ -297,7 +1309,10 @@ public:
     // Get running processes (for report)
     std::vector<Process*> getRunningProcesses() const {
         std::lock_guard<std::mutex> lock(const_cast<std::mutex&>(runningMutex));
-        return runningProcesses;
+        std::vector<Process*> running;
+        running.reserve(runningProcesses.size());
+        runningProcesses.forEach([&](Process* p) { running.push_back(p); });
+        return running;
     }
     
     // Get finished processes (for report)
@@ -305,15 +1320,127 @@ public:
         std::lock_guard<std::mutex> lock(const_cast<std::mutex&>(finishedMutex));
         return finishedProcesses;
     }
-    
-    // Get active core count (for report)
-    int countActiveCoresPublic() const {
-        return countActiveCores();
-    }
+
+    // Check the scheduler's bookkeeping; returns one line per violation.
+    // The CPU loop may keep running, but process and memory totals are only
+    // exact while no other thread is admitting, killing or migrating processes.
+    std::vector<std::string> checkInvariants() const {
+        std::lock_guard<std::mutex> coreLock(const_cast<std::mutex&>(coreMutex));
+        std::lock_guard<std::mutex> queueLock(const_cast<std::mutex&>(queueMutex));
+        std::lock_guard<std::mutex> runLock(const_cast<std::mutex&>(runningMutex));
+        std::lock_guard<std::mutex> finishedLock(const_cast<std::mutex&>(finishedMutex));
+        
+        std::vector<std::string> violations;
+        std::map<const Process*, int> listings;
+        int listed = 0;
+        long long liveMemory = 0;
+        int resident = 0;
+        
+        // Every process is in exactly one list, in the state that list implies
+        auto visit = [&](const Process* p, Process::ProcessState expected, const char* list) {
+            listed++;
+            if (listings[p]++ > 0) {
+                violations.push_back(p->getName() + " is listed again in " + list);
+            }
+            if (p->getState() != expected) {
+                violations.push_back(p->getName() + " in " + list + " is " + p->getStateString());
+            }
+            if (expected != Process::FINISHED) {
+                liveMemory += (long long)p->getMemoryRequired();
+                if (p->getMemoryRequired() > 0) resident++;
+            }
+        };
+        readyQueue.forEach([&](Process* p) { visit(p, Process::READY, "ready queue"); });
+        suspendedProcesses.forEach([&](Process* p) { visit(p, Process::SUSPENDED, "suspended list"); });
+        blockedProcesses.forEach([&](Process* p) { visit(p, Process::WAITING, "blocked list"); });
+        runningProcesses.forEach([&](Process* p) { visit(p, Process::RUNNING, "running list"); });
+        for (auto p : finishedProcesses) visit(p, Process::FINISHED, "finished list");
+        
+        // Running processes and cores agree one to one
+        std::map<const Process*, int> onCores;
+        for (auto core : cpuCores) {
+            Process* p = core->getProcess();
+            if (!p) continue;
+            onCores[p]++;
+            if (!runningProcesses.contains(p)) {
+                violations.push_back(p->getName() + " is on core " + std::to_string(core->getID()) +
+                                     " but not in the running list");
+            }
+        }
+        runningProcesses.forEach([&](Process* p) {
+            if (onCores[p] != 1) {
+                violations.push_back(p->getName() + " is running on " + std::to_string(onCores[p]) + " cores");
+            }
+        });
+        
+        // The name index holds exactly the unfinished processes
+        int indexed = 0;
+        for (const auto& entry : liveByName) {
+            auto listing = listings.find(entry.second);
+            if (listing == listings.end() || entry.second->getState() == Process::FINISHED) {
+                violations.push_back(entry.first + " is indexed but not live");
+            } else {
+                indexed++;
+            }
+        }
+        int live = listed - (int)finishedProcesses.size();
+        if (indexed != live) {
+            violations.push_back(std::to_string(indexed) + " processes indexed by name, " +
+                                 std::to_string(live) + " live");
+        }
+        
+        // The backfill index holds exactly the ready queue
+        if (config.schedulerType == "backfill") {
+            for (const auto& key : backfillIndex) {
+                if (!readyQueue.contains(std::get<3>(key))) {
+                    violations.push_back(std::get<3>(key)->getName() + " is a backfill candidate but not ready");
+                }
+            }
+            if ((int)backfillIndex.size() != readyQueue.size()) {
+                violations.push_back(std::to_string(backfillIndex.size()) + " backfill candidates, " +
+                                     std::to_string(readyQueue.size()) + " ready");
+            }
+        }
+        
+        // Sleepers are blocked processes waiting for their wake cycle
+        for (const auto& entry : sleepers) {
+            if (!blockedProcesses.contains(entry.second) || entry.second->getWakeCycle() != entry.first) {
+                violations.push_back(entry.second->getName() + " sleeps outside the blocked list");
+            }
+        }
+        
+        // No process lost: everything created is listed or was killed
+        if (listed + killedCount != totalProcessesCreated) {
+            violations.push_back("created " + std::to_string(totalProcessesCreated) + " but listed " +
+                                 std::to_string(listed) + " + killed " + std::to_string(killedCount.load()));
+        }
+        
+        // Memory held by live processes matches the counters and the backend
+        if (committedMemory != liveMemory) {
+            violations.push_back("committed memory " + std::to_string(committedMemory.load()) +
+                                 " B, live processes hold " + std::to_string(liveMemory) + " B");
+        }
+        if (slabAllocator && (long long)slabAllocator->getUsedMemory() != liveMemory) {
+            violations.push_back("slab allocator holds " + std::to_string(slabAllocator->getUsedMemory()) +
+                                 " B, live processes " + std::to_string(liveMemory) + " B");
+        }
+        std::lock_guard<std::mutex> vmLock(const_cast<std::mutex&>(vmMutex));
+        if (residentProcesses != resident) {
+            violations.push_back(std::to_string(residentProcesses) + " resident processes counted, " +
+                                 std::to_string(resident) + " hold memory");
+        }
+        return violations;
+    }
+    
+    // Get active core count (for report)
+    int countActiveCoresPublic() const {
+        return countActiveCores();
+    }
 
 private:
     // Count active CPU cores
     int countActiveCores() const {
+        std::lock_guard<std::mutex> lock(const_cast<std::mutex&>(coreMutex));
         int count = 0;
         for (auto core : cpuCores) {
             if (!core->idle()) count++;
@@ -321,6 +1448,417 @@ private:
         return count;
     }
 
+    // Lock a scheduler mutex, timing the wait only when another thread holds it
+    std::unique_lock<std::mutex> lockTimed(std::mutex& mutex) {
+        std::unique_lock<std::mutex> lock(mutex, std::try_to_lock);
+        if (!lock.owns_lock()) {
+            auto start = std::chrono::steady_clock::now();
+            lock.lock();
+            lockWaitNanos += std::chrono::duration_cast<std::chrono::nanoseconds>(
+                std::chrono::steady_clock::now() - start).count();
+            lockContentions++;
+        }
+        return lock;
+    }
+
+    // Put a process on the ready queue, ordered by the DAG priority policy.
+    // Only DAG members are ordered; they never pass an ordinary process.
+    // (caller holds queueMutex)
+    void enqueueReady(Process* p) {
+        p->setState(Process::READY);
+        p->setReadySinceCycle(currentCycle);
+        if (config.dagPriority == "critical-path" && p->getDagRunIndex() >= 0) {
+            readyQueue.insertSorted(p, [](const Process* q) {
+                return q->getDagRunIndex() >= 0 ? q->getCriticalPathLength() : LLONG_MAX;
+            });
+        } else {
+            readyQueue.pushBack(p);
+        }
+        if (config.schedulerType == "backfill") backfillIndex.insert(backfillKey(p));
+    }
+
+    // Take a process off the ready queue; false if it was not there
+    // (caller holds queueMutex)
+    bool removeReady(Process* p) {
+        if (!readyQueue.remove(p)) return false;
+        if (config.schedulerType == "backfill") backfillIndex.erase(backfillKey(p));
+        return true;
+    }
+
+    // Index key of a ready job; fixed while it stays in the ready queue
+    BackfillKey backfillKey(Process* p) const {
+        return BackfillKey(p->getRequiredCores(), estimatedCycles(p), p->getReadySinceCycle(), p);
+    }
+
+    // Release dependents of a finished or killed process and update its DAG run
+    // (caller holds queueMutex)
+    void retireFromDag(Process* p) {
+        for (auto child : p->getDependents()) {
+            if (child->releaseParent(p) && blockedProcesses.remove(child)) {
+                enqueueReady(child);
+            }
+        }
+        p->clearDependents();
+        
+        int index = p->getDagRunIndex();
+        if (index >= 0 && index < (int)dagRuns.size()) {
+            DagRun& run = dagRuns[index];
+            run.completedCount++;
+            if (run.completedCount == run.processCount) {
+                run.finishCycle = currentCycle;
+            }
+        }
+    }
+
+    // Kill the blocked dependents of a killed process, and theirs, since their
+    // parent will never finish (caller holds queueMutex). Returns how many.
+    int cancelDependents(Process* p) {
+        std::vector<Process*> dependents = p->getDependents();
+        p->clearDependents();
+        
+        int cancelled = 0;
+        for (auto child : dependents) {
+            if (!blockedProcesses.remove(child)) continue;
+            unindexProcess(child);
+            for (auto parent : child->getParents()) {
+                if (parent != p) parent->removeDependent(child);
+            }
+            cancelled += 1 + cancelDependents(child);
+            retireFromDag(child);
+            
+            releaseProcessMemory(child);
+            delete child;
+            killedCount++;
+        }
+        return cancelled;
+    }
+
+    // Find the core running a process (caller holds coreMutex)
+    CPUCore* findCoreRunning(const Process* p) {
+        for (auto core : cpuCores) {
+            if (core->getProcess() == p) return core;
+        }
+        return nullptr;
+    }
+
+    // Index a process by name once it is admitted (caller holds queueMutex)
+    void indexProcess(Process* p) {
+        liveByName.emplace(p->getName(), p);
+    }
+
+    // Drop a finished, killed or migrated process from the index (caller holds queueMutex)
+    void unindexProcess(Process* p) {
+        auto range = liveByName.equal_range(p->getName());
+        for (auto it = range.first; it != range.second; ++it) {
+            if (it->second == p) {
+                liveByName.erase(it);
+                return;
+            }
+        }
+    }
+
+    // A live process with this name that 'accept' allows; names are rarely
+    // shared, so this is O(1) on average (caller holds queueMutex)
+    template <typename Accept>
+    Process* findLive(const std::string& name, Accept accept) const {
+        auto range = liveByName.equal_range(name);
+        for (auto it = range.first; it != range.second; ++it) {
+            if (accept(it->second)) return it->second;
+        }
+        return nullptr;
+    }
+
+    // Create cores with fresh IDs, up to the 128-core limit (caller holds coreMutex)
+    int addCoresLocked(int count) {
+        int added = 0;
+        while (added < count && (int)cpuCores.size() < 128) {
+            CPUCore* core = new CPUCore(nextCoreID++);
+            if (config.cacheEnabled) {
+                core->enableCache(config);
+            }
+            if (!config.cstateThresholds.empty()) {
+                core->enableIdleStates(config.cstateThresholds, config.cstateExitLatencies);
+            }
+            cpuCores.push_back(core);
+            added++;
+        }
+        return added;
+    }
+
+    // Most cores any queued, suspended or running job needs (caller holds coreMutex)
+    int largestJobCores() {
+        int largest = 1;
+        for (auto core : cpuCores) {
+            if (core->getProcess()) largest = std::max(largest, core->getProcess()->getRequiredCores());
+        }
+        std::lock_guard<std::mutex> lock(queueMutex);
+        auto visit = [&](const Process* p) { largest = std::max(largest, p->getRequiredCores()); };
+        readyQueue.forEach(visit);
+        suspendedProcesses.forEach(visit);
+        return largest;
+    }
+
+    // Remove cores, idle ones first (caller holds coreMutex). A process on a
+    // removed core, or a multi-core job holding it, goes back to the ready queue.
+    // Stops short rather than leave a live job with fewer cores than it needs.
+    int removeCoresLocked(int count) {
+        int floor = largestJobCores();
+        int removed = 0;
+        while (removed < count && (int)cpuCores.size() > floor) {
+            // Prefer the newest idle core, then the newest busy one
+            int victim = (int)cpuCores.size() - 1;
+            for (int i = (int)cpuCores.size() - 1; i >= 0; i--) {
+                if (cpuCores[i]->idle()) {
+                    victim = i;
+                    break;
+                }
+            }
+            
+            CPUCore* core = cpuCores[victim];
+            Process* job = core->getProcess() ? core->getProcess() : core->getHeldBy();
+            if (job) {
+                CPUCore* primary = core;
+                for (auto c : cpuCores) {
+                    if (c->getProcess() == job) primary = c;
+                }
+                detachFromCores(job, primary);
+                
+                std::lock_guard<std::mutex> lock(queueMutex);
+                requeueFront(job);
+            }
+            
+            retiredCores.push_back(CoreStats::of(core, false));
+            cpuCores.erase(cpuCores.begin() + victim);
+            delete core;
+            removed++;
+        }
+        return removed;
+    }
+
+    // Put a drained process back at the head of the ready queue
+    // (caller holds queueMutex)
+    void requeueFront(Process* p) {
+        if (config.dagPriority == "critical-path" && p->getDagRunIndex() >= 0) {
+            enqueueReady(p);
+            return;
+        }
+        p->setState(Process::READY);
+        p->setReadySinceCycle(currentCycle);
+        readyQueue.pushFront(p);
+        if (config.schedulerType == "backfill") backfillIndex.insert(backfillKey(p));
+    }
+
+    // Record how long a process just dispatched waited in the ready queue
+    // (caller holds coreMutex)
+    void recordReadyWait(Process* p) {
+        if (p->getReadySinceCycle() < 0) return;
+        int wait = currentCycle - p->getReadySinceCycle();
+        
+        const int windowSize = 256;
+        if ((int)recentReadyWaits.size() < windowSize) {
+            recentReadyWaits.push_back(wait);
+        } else {
+            recentReadyWaits[recentReadyWaitsNext] = wait;
+            recentReadyWaitsNext = (recentReadyWaitsNext + 1) % windowSize;
+        }
+    }
+
+    // p99 over the recent-wait window (caller holds coreMutex)
+    int readyWaitP99() const {
+        if (recentReadyWaits.empty()) return 0;
+        std::vector<int> waits = recentReadyWaits;
+        size_t rank = (waits.size() * 99) / 100;
+        if (rank >= waits.size()) rank = waits.size() - 1;
+        std::nth_element(waits.begin(), waits.begin() + rank, waits.end());
+        return waits[rank];
+    }
+
+    // Grow when ready-queue wait p99 misses the target, shrink when a core
+    // sat idle for a whole interval (caller holds coreMutex)
+    void autoscaleCores() {
+        if (currentCycle % config.autoscaleInterval != 0) return;
+        
+        int cores = (int)cpuCores.size();
+        int waitP99 = readyWaitP99();
+        lastIntervalWaitP99 = waitP99;
+        
+        // Each decision only looks at waits seen during the last interval
+        recentReadyWaits.clear();
+        recentReadyWaitsNext = 0;
+        
+        if (waitP99 > config.autoscaleTargetWait && cores < config.autoscaleMaxCPUs) {
+            autoscaleAdds += addCoresLocked(1);
+            return;
+        }
+        
+        if (cores > config.autoscaleMinCPUs) {
+            for (auto core : cpuCores) {
+                if (core->idle() && core->getIdleStreak() >= config.autoscaleInterval) {
+                    autoscaleRemoves += removeCoresLocked(1);
+                    break;
+                }
+            }
+        }
+    }
+
+    // Count a MALLOC/FREE and serve any heap growth it asked for (caller holds coreMutex)
+    void recordHeapOperation(Process* p, const std::string& instruction) {
+        heapLatency.add(p->getLastHeapOpNanos());
+        size_t request = p->getHeapGrowthRequest();
+        if (request > 0) {
+            bool granted = resizeProcessMemory(p, request);
+            p->completeHeapGrowth(granted);
+            if (granted) heapGrowths++;
+            else heapGrowthFailures++;
+            return;
+        }
+        if (instruction.find("MALLOC") == 0) heapMallocs++;
+        else heapFrees++;
+    }
+
+    // Grow (or shrink) a process's memory region in the backend. A process
+    // with no region yet gets a fresh allocation.
+    // The slab backend only has its configured sizes: the region becomes the
+    // whole slot of the smallest class that fits, and a growth past the largest
+    // class gets that class if it is still bigger than the region, so the heap
+    // can grow part of the way before a MALLOC returns NULL.
+    bool resizeProcessMemory(Process* p, size_t newSize) {
+        size_t oldSize = p->getMemoryRequired();
+        if (slabAllocator) {
+            size_t slotSize = slabAllocator->slotSizeFor(newSize);
+            if (newSize > oldSize && slotSize <= oldSize) {
+                std::lock_guard<std::mutex> lock(vmMutex);
+                allocFailures++;
+                return false;
+            }
+            newSize = slotSize;
+        }
+        if (oldSize == 0) {
+            p->setMemoryRequired(newSize);
+            if (!allocateProcessMemory(p)) {
+                p->setMemoryRequired(0);
+                return false;
+            }
+            committedMemory += (long long)newSize;
+            return true;
+        }
+        
+        auto start = std::chrono::steady_clock::now();
+        bool resized = true;
+        bool lost = false;
+        if (slabAllocator) {
+            resized = slabAllocator->resizeMemory(p->getID(), newSize);
+        } else if (memoryManager) {
+            // MemoryManager has no resize: move the block, restoring the old one on failure
+            memoryManager->deallocateMemory(p->getID());
+            resized = memoryManager->allocateMemory(p->getID(), p->getName(), newSize);
+            if (!resized) {
+                lost = !memoryManager->allocateMemory(p->getID(), p->getName(), oldSize);
+            }
+        }
+        auto elapsed = std::chrono::steady_clock::now() - start;
+        if (resized) {
+            p->setMemoryRequired(newSize);
+            committedMemory += (long long)newSize - (long long)oldSize;
+        } else if (lost) {
+            // Someone took the space meanwhile; the process runs on without a region
+            p->loseMemoryRegion();
+            committedMemory -= (long long)oldSize;
+            heapRegionsLost++;
+        }
+        
+        std::lock_guard<std::mutex> lock(vmMutex);
+        allocLatency.add(std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count());
+        if (resized) allocSuccesses++;
+        else allocFailures++;
+        if (lost) residentProcesses--;
+        return resized;
+    }
+
+    // Reserve a process's memory from the slab backend if sizes are discrete,
+    // otherwise from the MemoryManager
+    bool allocateProcessMemory(Process* p) {
+        auto start = std::chrono::steady_clock::now();
+        bool allocated = true;
+        if (slabAllocator) {
+            allocated = slabAllocator->allocateMemory(p->getID(), p->getName(), p->getMemoryRequired());
+        } else if (memoryManager) {
+            allocated = memoryManager->allocateMemory(p->getID(), p->getName(), p->getMemoryRequired());
+        }
+        auto elapsed = std::chrono::steady_clock::now() - start;
+        
+        if (allocated) {
+            TRACE_PROBE4(mem_alloc, p->getID(), p->getAssignedCore(), (int)currentCycle, p->getMemoryRequired());
+        }
+        
+        std::lock_guard<std::mutex> lock(vmMutex);
+        allocLatency.add(std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count());
+        if (allocated) {
+            allocSuccesses++;
+            residentProcesses++;
+        } else {
+            allocFailures++;
+        }
+        return allocated;
+    }
+
+    // Allocate a process's memory (if it needs any) and charge it as committed
+    bool reserveProcessMemory(Process* p) {
+        if (p->getMemoryRequired() > 0 && !allocateProcessMemory(p)) {
+            return false;
+        }
+        committedMemory += (long long)p->getMemoryRequired();
+        return true;
+    }
+
+    // Give back a process's memory to whichever backend holds it
+    void releaseProcessMemory(Process* p) {
+        auto start = std::chrono::steady_clock::now();
+        if (slabAllocator) {
+            slabAllocator->deallocateMemory(p->getID());
+        } else if (memoryManager) {
+            memoryManager->deallocateMemory(p->getID());
+        }
+        auto elapsed = std::chrono::steady_clock::now() - start;
+        committedMemory -= (long long)p->getMemoryRequired();
+        
+        std::lock_guard<std::mutex> lock(vmMutex);
+        if (p->getMemoryRequired() > 0) {
+            TRACE_PROBE4(mem_free, p->getID(), p->getAssignedCore(), (int)currentCycle, p->getMemoryRequired());
+            freeLatency.add(std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count());
+            memoryFrees++;
+            residentProcesses--;
+        }
+    }
+
+    // Take a running process off its core, any cores it holds and the
+    // backfill profile (caller holds coreMutex)
+    void detachFromCores(Process* p, CPUCore* core) {
+        removeFromRunning(p);
+        core->releaseProcess();
+        
+        if (p->getRequiredCores() > 1) {
+            for (auto c : cpuCores) {
+                if (c->getHeldBy() == p) c->releaseHold();
+            }
+        }
+        
+        auto range = availabilityProfile.equal_range(p->getExpectedEndCycle());
+        for (auto it = range.first; it != range.second; ++it) {
+            if (it->second == p) {
+                availabilityProfile.erase(it);
+                break;
+            }
+        }
+        p->setExpectedEndCycle(-1);
+    }
+
+    // Drop a process from the running list
+    void removeFromRunning(Process* p) {
+        std::lock_guard<std::mutex> lock(runningMutex);
+        runningProcesses.remove(p);
+    }
+
     // Create directory if it doesn't exist (cross-platform using system command)
     void createDirectoryIfNotExists(const std::string& path) {
         #ifdef _WIN32
@@ -330,11 +1868,19 @@ private:
         #endif
     }
 
+    // Create the logs directory once instead of shelling out for every process
+    void ensureLogsDirectory() {
+        if (!logsDirectoryReady.exchange(true)) {
+            createDirectoryIfNotExists("logs");
+        }
+    }
+
     // Get formatted timestamp (MM/DD/YYYY, HH:MM:SS AM/PM)
     std::string getFormattedTimestamp() {
         auto now = std::chrono::system_clock::now();
         std::time_t now_time = std::chrono::system_clock::to_time_t(now);
-        std::tm* local_time = std::localtime(&now_time);
+        std::tm local = localTimeOf(now_time);
+        std::tm* local_time = &local;
         
         std::ostringstream oss;
         // Format: MM/DD/YYYY, HH:MM:SS AM/PM
@@ -358,8 +1904,13 @@ private:
     // Initialize process log file
     void initializeProcessLog(Process* process) {
         // Create logs directory
-        createDirectoryIfNotExists("logs");
+        ensureLogsDirectory();
         
+        writeProcessLogHeader(process);
+    }
+
+    // Point the process at its log file and write the header (directory must exist)
+    void writeProcessLogHeader(Process* process) {
         // Set log file path
         std::string logPath = "logs/" + process->getName() + ".txt";
         process->setLogFilePath(logPath);
@@ -374,80 +1925,424 @@ private:
     }
 
     // Main CPU execution loop
+    // Cycles are paced against absolute deadlines so work time does not
+    // stretch the tick. A cycle that ends past its deadline is an overrun,
+    // handled by config.tickPolicy:
+    //   skip  - drop the missed deadlines and stay on the original grid
+    //   burst - run the missed cycles back-to-back to catch up (bounded)
+    //   slow  - start a new grid from now (the simulated clock slips)
     void cpuExecutionLoop() {
+        const auto tick = std::chrono::milliseconds(config.cycleMs);
+        const int maxBurst = 10;
+        int burst = 0;
+        auto deadline = std::chrono::steady_clock::now() + tick;
+        
         while (isRunning) {
-            currentCycle++;
+            {
+                auto coreLock = lockTimed(coreMutex);
+                runCycle();
+            }
             
-            // Assign processes to idle cores
-            assignProcessesToCores();
+            auto now = std::chrono::steady_clock::now();
+            std::unique_lock<std::mutex> tickLock(tickMutex);
+            ticks++;
             
-            // Execute one cycle on all cores
-            for (auto core : cpuCores) {
-                if (!core->idle()) {
-                    Process* p = core->getProcess();
+            if (now <= deadline) {
+                burst = 0;
+                tickLock.unlock();
+                std::this_thread::sleep_until(deadline);
+                tickLock.lock();
+                auto late = std::chrono::steady_clock::now() - deadline;
+                tickJitter.add(std::chrono::duration_cast<std::chrono::microseconds>(late).count());
+                deadline += tick;
+                continue;
+            }
+            
+            auto overrun = now - deadline;
+            tickOverruns.add(std::chrono::duration_cast<std::chrono::microseconds>(overrun).count());
+            
+            if (config.tickPolicy == "skip") {
+                long long missed = overrun / tick + 1;
+                skippedTicks += missed - 1;
+                deadline += tick * missed;
+            } else if (config.tickPolicy == "burst" && burst < maxBurst) {
+                burst++;
+                burstTicks++;
+                deadline += tick;
+            } else {
+                // "slow", or a burst that could not catch up: rebase on now
+                burst = 0;
+                deadline = now + tick;
+            }
+        }
+    }
+
+    // Simulate one CPU cycle on every core (caller holds coreMutex)
+    void runCycle() {
+        currentCycle++;
+        
+        if (config.autoscale) {
+            autoscaleCores();
+        }
+        
+        wakeSleepers();
+        
+        // Assign processes to idle cores
+        assignProcessesToCores();
+        
+        if (config.smtThreads > 1) {
+            shareSmtThroughput();
+        }
+        
+        if (profiler && profiler->due(currentCycle)) {
+            sampleCores();
+        }
+        
+        // Execute one cycle on all cores
+        for (auto core : cpuCores) {
+            core->accountCycle();
+            if (!core->idle()) {
+                Process* p = core->getProcess();
+                
+                if (p && !core->isBusyWaiting()) {
+                    // Only log when actually executing an instruction (not busy-waiting)
+                    std::string instruction = p->getCurrentInstruction();
                     
-                    if (p && !core->isBusyWaiting()) {
-                        // Only log when actually executing an instruction (not busy-waiting)
-                        std::string instruction = p->getCurrentInstruction();
-                        
-                        // Execute the instruction (updates registers) with delay
-                        core->executeCycle(config.delayPerExec);
-                        
-                        // Write log entry only for actual instruction execution
-                        if (!instruction.empty()) {
-                            std::string timestamp = getFormattedTimestamp();
-                            std::string logMessage = instruction;
-                            
-                            // For ADD and VAR, show the result/value of X
-                            if (instruction.find("ADD") == 0 || instruction.find("VAR") == 0) {
-                                logMessage += " | X = " + std::to_string(p->getRegisterA());
-                            }
-                            
-                            p->writeLog(timestamp, core->getID(), logMessage);
-                        }
-                    } else if (p && core->isBusyWaiting()) {
-                        // Just busy-wait, don't execute instruction
-                        core->executeCycle(config.delayPerExec);
-                    }
+                    // Execute the instruction (updates registers) with delay
+                    bool executed = core->executeCycle(config.delayPerExec);
                     
-                    // Check if process finished
-                    if (core->processFinished()) {
-                        moveToFinished(core);
+                    bool heapOp = (instruction.find("MALLOC") == 0 || instruction.find("FREE") == 0);
+                    if (executed && heapOp) {
+                        recordHeapOperation(p, instruction);
+                    }
+                    if (executed && instruction.find("SYSCALL") == 0) {
+                        enterSyscall(core, p);
                     }
-                    // Check for preemption (Round Robin)
-                    else if (config.schedulerType == "rr" && 
-                             core->getExecutedCycles() >= config.quantumCycles) {
-                        preemptProcess(core);
+                    
+                    // Write log entry only for actual instruction execution
+                    if (executed && !instruction.empty()) {
+                        std::string timestamp = getFormattedTimestamp();
+                        std::string logMessage = instruction;
+                        
+                        // For ADD and VAR, show the result/value of X
+                        if (instruction.find("ADD") == 0 || instruction.find("VAR") == 0) {
+                            logMessage += " | X = " + std::to_string(p->getRegisterA());
+                        } else if (heapOp) {
+                            logMessage += p->getHeapNote();
+                        } else if (instruction.find("SYSCALL") == 0 && p->getLastSyscall() == Process::SYS_GETPID) {
+                            logMessage += " | pid = " + std::to_string(p->getResult());
+                        }
+                        
+                        p->writeLog(timestamp, core->getID(), logMessage);
+                        TRACE_PROBE3(log_flush, p->getID(), core->getID(), (int)currentCycle);
                     }
+                } else if (p && core->isBusyWaiting()) {
+                    // Just busy-wait, don't execute instruction
+                    core->executeCycle(config.delayPerExec);
+                }
+                
+                // Apply a SYSCALL whose kernel cost is paid (yield, sleep, IO). If it
+                // was the last instruction, a sleep or IO still blocks the process
+                // before it finishes (a finished process is never preempted).
+                int syscall = core->takeDueSyscall();
+                if (syscall >= 0) {
+                    completeSyscall(core, syscall);
+                }
+                
+                // Check if process finished, once its last SYSCALL's kernel time is paid
+                if (core->processFinished()) {
+                    if (!core->inKernel()) moveToFinished(core);
+                }
+                // Check for preemption (Round Robin), never in the middle of kernel mode
+                else if (syscall < 0 && config.schedulerType == "rr" && !core->inKernel() &&
+                         core->getExecutedCycles() >= config.quantumCycles) {
+                    preemptProcess(core);
                 }
             }
+        }
+        
+        recordQueueingSample();
+    }
+
+    // Record what every running core is about to spend this cycle on (caller holds coreMutex)
+    void sampleCores() {
+        for (int slot = 0; slot < (int)cpuCores.size(); slot++) {
+            CPUCore* core = cpuCores[slot];
+            Process* p = core->getProcess();
+            if (!p) continue;
             
-            // Fixed 100ms per CPU cycle
-            std::this_thread::sleep_for(std::chrono::milliseconds(100));
+            ProfileSample sample;
+            sample.pid = p->getID();
+            sample.syscall = -1;
+            Profiler::setName(sample, p->getName());
+            if (core->inKernel()) {
+                // The PC has already moved past the SYSCALL being serviced
+                sample.pc = p->getInstructionsExecuted() - 1;
+                sample.opcode = Profiler::OP_SYSCALL;
+                sample.state = Profiler::KERNEL;
+                sample.syscall = (int8_t)core->getPendingSyscall();
+            } else {
+                sample.pc = p->getInstructionsExecuted();
+                sample.opcode = Profiler::opcodeOf(p->getCurrentInstruction());
+                sample.state = core->getDelayCyclesRemaining() > 0 ? Profiler::STALLED : Profiler::RUNNING;
+            }
+            profiler->record(slot, sample);
+        }
+    }
+
+    // Count a SYSCALL and put its core into kernel mode (caller holds coreMutex)
+    void enterSyscall(CPUCore* core, Process* p) {
+        int syscall = p->getLastSyscall();
+        if (syscall < 0 || syscall > Process::SYS_IO) return;
+        syscallCounts[syscall]++;
+        if (syscall == Process::SYS_SLEEP || syscall == Process::SYS_IO) {
+            blockedSyscallCycles += p->getLastSyscallArg();
+        }
+        core->enterKernel(config.syscallCost, syscall);
+    }
+
+    // Apply a SYSCALL's scheduling effect once its kernel cost is paid:
+    // yield goes through the normal preempt path, sleep and IO block the
+    // process until its wake cycle (caller holds coreMutex)
+    void completeSyscall(CPUCore* core, int syscall) {
+        Process* p = core->getProcess();
+        if (syscall == Process::SYS_YIELD) {
+            preemptProcess(core);
+        } else if ((syscall == Process::SYS_SLEEP || syscall == Process::SYS_IO) &&
+                   p->getLastSyscallArg() > 0) {
+            detachFromCores(p, core);
+            p->setState(Process::WAITING);
+            p->setWakeCycle(currentCycle + p->getLastSyscallArg());
+            
+            std::lock_guard<std::mutex> lock(queueMutex);
+            blockedProcesses.pushBack(p);
+            sleepers.insert({p->getWakeCycle(), p});
+        }
+    }
+
+    // Move sleepers whose wake cycle has come back to the ready queue (caller holds coreMutex)
+    void wakeSleepers() {
+        std::lock_guard<std::mutex> lock(queueMutex);
+        while (!sleepers.empty() && sleepers.begin()->first <= currentCycle) {
+            Process* p = sleepers.begin()->second;
+            sleepers.erase(sleepers.begin());
+            blockedProcesses.remove(p);
+            p->setWakeCycle(-1);
+            enqueueReady(p);
+        }
+    }
+
+    // Forget a sleeping process that is being killed (caller holds queueMutex)
+    void removeSleeper(Process* p) {
+        if (p->getWakeCycle() < 0) return;
+        auto range = sleepers.equal_range(p->getWakeCycle());
+        for (auto it = range.first; it != range.second; ++it) {
+            if (it->second == p) {
+                sleepers.erase(it);
+                break;
+            }
+        }
+        p->setWakeCycle(-1);
+    }
+
+    // Physical core of a logical core under SMT
+    int physicalCoreOf(const CPUCore* core) const {
+        return core->getID() / config.smtThreads;
+    }
+
+    // Set each thread's share of its physical core from how many siblings
+    // are running this cycle, and count physical-core usage (caller holds coreMutex)
+    void shareSmtThroughput() {
+        std::map<int, int> running;
+        for (auto core : cpuCores) {
+            int& count = running[physicalCoreOf(core)];
+            if (core->getProcess()) count++;
+        }
+        for (auto core : cpuCores) {
+            int siblings = running[physicalCoreOf(core)];
+            core->setSmtSpeed(1.0 / (1.0 + config.smtContention * std::max(0, siblings - 1)));
+        }
+        for (const auto& entry : running) {
+            PhysicalCoreStats& stats = physicalStats[entry.first];
+            stats.physicalID = entry.first;
+            if (entry.second > 0) stats.busyCycles++;
+            else stats.idleCycles++;
+            if (entry.second > 1) stats.sharedCycles++;
+        }
+    }
+
+    // Next idle core to dispatch to, or nullptr. With SMT "spread" placement
+    // this is the idle thread with the fewest busy siblings; with
+    // cstate-prefer-shallow, ties go to the shallowest idle state (caller holds coreMutex)
+    CPUCore* pickIdleCore() const {
+        bool spread = (config.smtThreads > 1 && config.smtPlacement == "spread");
+        CPUCore* best = nullptr;
+        int bestSiblings = 0;
+        int bestState = 0;
+        for (auto core : cpuCores) {
+            if (!core->idle()) continue;
+            if (!spread && !config.cstatePreferShallow) return core;
+            int siblings = 0;
+            if (spread) {
+                for (auto other : cpuCores) {
+                    if (!other->idle() && physicalCoreOf(other) == physicalCoreOf(core)) siblings++;
+                }
+            }
+            int state = config.cstatePreferShallow ? core->getIdleState() : 0;
+            if (!best || siblings < bestSiblings || (siblings == bestSiblings && state < bestState)) {
+                best = core;
+                bestSiblings = siblings;
+                bestState = state;
+            }
+        }
+        return best;
+    }
+
+    // Feed this cycle's arrivals and queue lengths to the analytics (caller holds coreMutex)
+    void recordQueueingSample() {
+        int running = 0;
+        for (auto core : cpuCores) {
+            if (core->getProcess()) running++;
+        }
+        int ready;
+        {
+            std::lock_guard<std::mutex> lock(queueMutex);
+            ready = readyQueue.size();
         }
+        analytics.recordCycle(arrivalsThisCycle.exchange(0), ready, running, (int)cpuCores.size());
     }
 
     // Assign processes from ready queue to idle cores
     void assignProcessesToCores() {
+        if (config.schedulerType == "backfill") {
+            backfillProcessesToCores();
+            return;
+        }
+        
+        for (CPUCore* core = pickIdleCore(); core; core = pickIdleCore()) {
+            auto lock = lockTimed(queueMutex);
+            if (readyQueue.empty()) break;
+            Process* p = readyQueue.popFront();
+            
+            // Set start time if first time running
+            if (p->getStartTime().empty()) {
+                p->setStartTime(getCurrentTimeString());
+            }
+            
+            recordReadyWait(p);
+            core->assignProcess(p);
+            TRACE_PROBE3(dispatch, p->getID(), core->getID(), (int)currentCycle);
+            
+            {
+                std::lock_guard<std::mutex> runLock(runningMutex);
+                runningProcesses.pushBack(p);
+            }
+        }
+    }
+
+    // Cycles a job is expected to occupy its cores, from its estimate
+    int estimatedCycles(const Process* p) const {
+        return std::max(1, p->getEstimatedInstructions() - p->getInstructionsExecuted()) *
+               (config.delayPerExec + 1);
+    }
+
+    // Start a ready job on 'cores' idle cores: the first runs it, the rest are held
+    // (caller holds coreMutex and queueMutex)
+    void startJob(Process* p, int cores) {
+        removeReady(p);
+        if (p->getStartTime().empty()) {
+            p->setStartTime(getCurrentTimeString());
+        }
+        recordReadyWait(p);
+        
+        bool primaryAssigned = false;
+        int held = 0;
         for (auto core : cpuCores) {
-            if (core->idle()) {
-                std::lock_guard<std::mutex> lock(queueMutex);
-                if (!readyQueue.empty()) {
-                    Process* p = readyQueue.front();
-                    readyQueue.pop();
-                    
-                    // Set start time if first time running
-                    if (p->getStartTime().empty()) {
-                        p->setStartTime(getCurrentTimeString());
-                    }
-                    
-                    core->assignProcess(p);
-                    
-                    {
-                        std::lock_guard<std::mutex> runLock(runningMutex);
-                        runningProcesses.push_back(p);
-                    }
-                }
+            if (!core->idle()) continue;
+            if (!primaryAssigned) {
+                core->assignProcess(p);
+                TRACE_PROBE3(dispatch, p->getID(), core->getID(), (int)currentCycle);
+                primaryAssigned = true;
+            } else if (held < cores - 1) {
+                core->holdFor(p);
+                held++;
+            }
+            if (primaryAssigned && held == cores - 1) break;
+        }
+        
+        p->setExpectedEndCycle(currentCycle + estimatedCycles(p));
+        availabilityProfile.insert(std::make_pair(p->getExpectedEndCycle(), p));
+        
+        std::lock_guard<std::mutex> runLock(runningMutex);
+        runningProcesses.pushBack(p);
+    }
+
+    // EASY backfilling: start jobs in order while they fit; when the head does
+    // not fit, reserve the earliest cycle it can start (the "shadow" time) and
+    // let later jobs jump ahead only if they cannot delay that reservation.
+    void backfillProcessesToCores() {
+        int freeCores = 0;
+        for (auto core : cpuCores) {
+            if (core->idle()) freeCores++;
+        }
+        if (freeCores == 0) return;
+        
+        auto lock = lockTimed(queueMutex);
+        
+        // Plain FCFS while the head fits
+        Process* head = readyQueue.front();
+        while (head && head->getRequiredCores() <= freeCores) {
+            freeCores -= head->getRequiredCores();
+            startJob(head, head->getRequiredCores());
+            head = readyQueue.front();
+        }
+        if (!head || freeCores == 0) return;
+        
+        // Walk running jobs by estimated end until enough cores free up for the head
+        int now = currentCycle;
+        int shadowCycle = -1;
+        int extraCores = 0;
+        int available = freeCores;
+        for (const auto& entry : availabilityProfile) {
+            available += entry.second->getRequiredCores();
+            if (available >= head->getRequiredCores()) {
+                shadowCycle = std::max(entry.first, now + 1);
+                extraCores = available - head->getRequiredCores();
+                break;
+            }
+        }
+        // The head can never fit with the current cores: nothing to reserve,
+        // so skip it and let the jobs behind it start freely
+        if (shadowCycle < 0) {
+            shadowCycle = INT_MAX;
+            extraCores = freeCores;
+        }
+        
+        // Backfill jobs that finish before the shadow time, shortest first within
+        // each core count: they are a prefix of that count's slice of the index.
+        // The head needs more than freeCores, so it is never picked.
+        long long window = (long long)shadowCycle - now;
+        for (int cores = 1; cores <= freeCores; cores++) {
+            auto it = backfillIndex.lower_bound(BackfillKey(cores, INT_MIN, INT_MIN, nullptr));
+            while (cores <= freeCores && it != backfillIndex.end() &&
+                   std::get<0>(*it) == cores && std::get<1>(*it) <= window) {
+                Process* p = std::get<3>(*(it++));
+                freeCores -= cores;
+                startJob(p, cores);
+                backfilledCount++;
+            }
+        }
+        
+        // Then jobs that run past the shadow time but only use the extra cores
+        for (int cores = 1; cores <= std::min(extraCores, freeCores); cores++) {
+            auto it = backfillIndex.lower_bound(BackfillKey(cores, INT_MIN, INT_MIN, nullptr));
+            while (cores <= std::min(extraCores, freeCores) && it != backfillIndex.end() &&
+                   std::get<0>(*it) == cores) {
+                Process* p = std::get<3>(*(it++));
+                extraCores -= cores;
+                freeCores -= cores;
+                startJob(p, cores);
+                backfilledCount++;
             }
         }
     }
@@ -458,26 +2353,26 @@ private:
         if (p) {
             p->setState(Process::FINISHED);
             p->setFinishTime(getCurrentTimeString());
+            p->setFinishCycle(currentCycle);
+            TRACE_PROBE3(finish, p->getID(), core->getID(), p->getFinishCycle());
+            analytics.recordCompletion(p->getCpuCycles());
             
             {
                 std::lock_guard<std::mutex> lock(finishedMutex);
                 finishedProcesses.push_back(p);
             }
             
+            detachFromCores(p, core);
+
+            // Drop it from the name index and release DAG dependents now that it is done
             {
-                std::lock_guard<std::mutex> lock(runningMutex);
-                runningProcesses.erase(
-                    std::remove(runningProcesses.begin(), runningProcesses.end(), p),
-                    runningProcesses.end()
-                );
+                std::lock_guard<std::mutex> lock(queueMutex);
+                unindexProcess(p);
+                if (p->getDagRunIndex() >= 0) retireFromDag(p);
             }
 
             // NEW: deallocate memory for this process
-            if (memoryManager) {
-                memoryManager->deallocateMemory(p->getID());
-            }
-            
-            core->releaseProcess();
+            releaseProcessMemory(p);
         }
     }
 
@@ -485,27 +2380,95 @@ private:
     void preemptProcess(CPUCore* core) {
         Process* p = core->getProcess();
         if (p && !p->isFinished()) {
-            p->setState(Process::READY);
+            TRACE_PROBE3(preempt, p->getID(), core->getID(), (int)currentCycle);
+            detachFromCores(p, core);
             
             {
-                std::lock_guard<std::mutex> lock(runningMutex);
-                runningProcesses.erase(
-                    std::remove(runningProcesses.begin(), runningProcesses.end(), p),
-                    runningProcesses.end()
-                );
+                std::lock_guard<std::mutex> lock(queueMutex);
+                enqueueReady(p);
             }
-            
+        }
+    }
+
+    // Build a fully formed process: program generated and log header written
+    Process* buildProcess(const std::string& name, int id, const std::string& arrival, std::mt19937& rng) {
+        std::uniform_int_distribution<int> instructionDist(config.minInstructions, config.maxInstructions);
+        return buildProcess(name, id, arrival, instructionDist(rng), rng);
+    }
+
+    // Same, with a fixed instruction count
+    Process* buildProcess(const std::string& name, int id, const std::string& arrival,
+                          int instructions, std::mt19937& rng) {
+        std::uniform_int_distribution<int> addDist(1, 10);
+        
+        Process* p = new Process(name, id, instructions, arrival);
+        p->generateInstructions(instructions, [&]() { return addDist(rng); });
+        if (config.heapOpsPercent > 0) {
+            p->addHeapOperations(config.heapOpsPercent, config.heapMaxAlloc, rng);
+        }
+        if (config.syscallOpsPercent > 0) {
+            p->addSyscalls(config.syscallOpsPercent, config.syscallSleepMax, config.syscallIoCycles, rng);
+        }
+        writeProcessLogHeader(p);
+        return p;
+    }
+
+    // Build the next auto-generated process, including its memory request
+    Process* buildGeneratedProcess(std::mt19937& rng) {
+        return createGeneratedProcess(reserveProcessIDs(1), rng);
+    }
+
+    // Background producer keeping warmPool topped up ahead of arrivals
+    void prefetchLoop() {
+        std::mt19937 rng((unsigned int)rand());
+        ensureLogsDirectory();
+        
+        while (autoGenerateProcesses) {
             {
-                std::lock_guard<std::mutex> lock(queueMutex);
-                readyQueue.push(p);
+                std::unique_lock<std::mutex> lock(poolMutex);
+                poolNotFull.wait(lock, [this]() {
+                    return !autoGenerateProcesses || (int)warmPool.size() < config.prefetchPoolSize;
+                });
             }
+            if (!autoGenerateProcesses) break;
+            
+            Process* p = buildGeneratedProcess(rng);
             
-            core->releaseProcess();
+            std::lock_guard<std::mutex> lock(poolMutex);
+            warmPool.push_back(p);
+            trimWarmPoolLocked();
+        }
+    }
+
+    // Drop the youngest prefetched processes beyond prefetchPoolSize, e.g. after
+    // a deferred arrival went back to the head (caller holds poolMutex)
+    void trimWarmPoolLocked() {
+        while ((int)warmPool.size() > std::max(1, config.prefetchPoolSize)) {
+            delete warmPool.back();
+            warmPool.pop_back();
+        }
+    }
+
+    // Take the next ready-made process, building one inline if the pool ran dry
+    Process* takeWarmProcess(std::mt19937& fallbackRng) {
+        {
+            std::lock_guard<std::mutex> lock(poolMutex);
+            if (!warmPool.empty()) {
+                Process* p = warmPool.front();
+                warmPool.pop_front();
+                poolNotFull.notify_one();
+                return p;
+            }
         }
+        poolMisses++;
+        ensureLogsDirectory();
+        return buildGeneratedProcess(fallbackRng);
     }
 
     // Automatic process generation loop
     void processGenerationLoop() {
+        std::mt19937 fallbackRng((unsigned int)rand());
+        
         while (autoGenerateProcesses) {
             // Wait based on batch frequency
             std::this_thread::sleep_for(
@@ -514,52 +2477,28 @@ private:
             
             if (!autoGenerateProcesses) break;
             
-            // Generate random instruction count
-            int instructions = config.minInstructions + 
-                (rand() % (config.maxInstructions - config.minInstructions + 1));
-            
-            // Create new process
-            std::string name = "Process_" + std::to_string(totalProcessesCreated);
-            Process* newProcess = new Process(
-                name,
-                totalProcessesCreated,
-                instructions,
-                getCurrentTimeString()
-            );
-
-            // NEW: allocate memory for auto-generated process
-            size_t memSize = config.minMemPerProc;
-            if (config.maxMemPerProc > config.minMemPerProc) {
-                memSize = config.minMemPerProc + 
-                    (rand() % (static_cast<int>(config.maxMemPerProc - config.minMemPerProc + 1)));
-            }
+            // Arrival is a handoff of a process the prefetcher already built
+            Process* newProcess = takeWarmProcess(fallbackRng);
+            newProcess->setArrivalTime(getCurrentTimeString());
 
-            if (!memoryManager || 
-                !memoryManager->allocateMemory(newProcess->getID(), newProcess->getName(), memSize)) {
+            // NEW: allocate memory for auto-generated process (admitted directly
+            // when there is no memory backend)
+            if (!admitProcess(newProcess)) {
                 std::cout << "WARNING: Unable to allocate memory for auto process '"
-                          << name << "'. Skipping process creation.\n";
-                delete newProcess;
+                          << newProcess->getName() << "'. Deferring to next arrival.\n";
+                // Keep it at the head of the pool so arrival order is preserved
+                std::lock_guard<std::mutex> lock(poolMutex);
+                warmPool.push_front(newProcess);
+                trimWarmPoolLocked();
                 continue;
             }
-            
-            // Generate instructions (VAR, PRINT, ADD pattern)
-            newProcess->generateInstructions(instructions);
-            
-            // Initialize log file for this process
-            initializeProcessLog(newProcess);
-            
-            totalProcessesCreated++;
-            addProcess(newProcess);
         }
     }
 
     // Get current time as string
     std::string getCurrentTimeString() {
         auto now = std::chrono::system_clock::now();
-        std::time_t now_time = std::chrono::system_clock::to_time_t(now);
-        std::string timeStr = std::ctime(&now_time);
-        timeStr.pop_back(); // Remove newline
-        return timeStr;
+        return ctimeString(std::chrono::system_clock::to_time_t(now));
     }
 };
 
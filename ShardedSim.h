@@ -0,0 +1,468 @@
+#ifndef SHARDED_SIM_H
+#define SHARDED_SIM_H
+
+#include <vector>
+#include <string>
+#include <atomic>
+#include <thread>
+#include <chrono>
+#include <random>
+#include <iostream>
+#include <iomanip>
+#include <new>
+#include <cstdint>
+#include <cstdlib>
+#include <cerrno>
+#include "Config.h"
+#include "Process.h"
+#include "Scheduler.h"
+
+#ifndef _WIN32
+#include <sys/mman.h>
+#include <sys/wait.h>
+#include <signal.h>
+#include <unistd.h>
+#endif
+
+/**
+ * ShardedSim - Splits one simulation across several shards, each owning a
+ * Scheduler with config.numCPUs cores.
+ *
+ * Shard 0 is the front end: process k arrives there every batchProcessFreq
+ * cycles and is routed to shard k % shards. Arrivals and migrations travel as
+ * small messages through single-producer/single-consumer rings, one per
+ * (source, destination) pair, and land exactly 'lookahead' cycles after they
+ * were sent. A shard may run cycle t once every other shard has finished
+ * cycle t - lookahead (conservative synchronization), so every message it
+ * could receive at t is already in its rings.
+ *
+ * Programs are rebuilt from (seed, k) wherever a process lands, so messages
+ * only carry its position. Because delivery times and drain order are fixed,
+ * running the shards as separate OS processes over a shared-memory segment
+ * gives the same result as running them inline in one process. runSingle()
+ * feeds the same arrivals to one plain Scheduler holding every shard's cores,
+ * as a baseline (identical results when there is one shard).
+ */
+class ShardedSim {
+public:
+    static const int MAX_SHARDS = 64;
+
+    // Per-shard outcome, written by the shard into the shared segment
+    struct ShardResult {
+        int arrivals;
+        int finished;
+        int migratedIn;
+        int migratedOut;
+        unsigned long long checksum;   // Sum of per-process hashes of the finish state
+    };
+
+private:
+    // A process on its way to a shard (new arrival or migration)
+    struct Message {
+        int processIndex;
+        int executed;
+        int valueOfX;
+        int deliverCycle;
+        int migrated;       // 0 for a new arrival
+    };
+
+    // Lock-free SPSC ring: the source shard only moves tail, the destination only head
+    struct Ring {
+        Message* slots;         // 'capacity' slots, after the rings in the same segment
+        uint64_t capacity;      // Power of two, see ringCapacity()
+        alignas(64) std::atomic<uint64_t> head;
+        alignas(64) std::atomic<uint64_t> tail;
+
+        bool push(const Message& m) {
+            uint64_t t = tail.load(std::memory_order_relaxed);
+            if (t - head.load(std::memory_order_acquire) >= capacity) return false;
+            slots[t & (capacity - 1)] = m;
+            tail.store(t + 1, std::memory_order_release);
+            return true;
+        }
+
+        // Next message, if any, without consuming it
+        const Message* peek() const {
+            uint64_t h = head.load(std::memory_order_relaxed);
+            if (h == tail.load(std::memory_order_acquire)) return nullptr;
+            return &slots[h & (capacity - 1)];
+        }
+
+        void pop() {
+            head.store(head.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+        }
+    };
+
+    // Layout of the shared segment: header, then shards*shards rings, then their slots
+    struct Segment {
+        alignas(64) std::atomic<int> progress[MAX_SHARDS];  // Last completed cycle per shard
+        std::atomic<int> overflowed;                        // A send found its ring full
+        std::atomic<int> aborted;                           // A shard died; the rest stop waiting
+        ShardResult results[MAX_SHARDS];
+    };
+
+    static_assert(std::atomic<uint64_t>::is_always_lock_free, "rings need lock-free 64-bit atomics");
+    static_assert(std::atomic<int>::is_always_lock_free, "progress needs lock-free atomics");
+
+    SystemConfig config;
+    int shards;
+    int cycles;
+    int processCount;
+    unsigned int seed;
+    int lookahead;
+
+    Segment* segment;
+    Ring* rings;
+    size_t segmentBytes;
+    bool segmentShared;
+    int resultShards;       // Rows in the last run's results (1 after runSingle)
+    int resultCores;        // Cores per row
+
+public:
+    ShardedSim(const SystemConfig& cfg, int shardCount, int cycleCount, int processes, unsigned int runSeed)
+        : config(cfg),
+          shards(shardCount),
+          cycles(cycleCount),
+          processCount(processes),
+          seed(runSeed),
+          lookahead(std::max(1, cfg.networkDelay)),
+          segment(nullptr),
+          rings(nullptr),
+          segmentBytes(0),
+          segmentShared(false),
+          resultShards(shardCount),
+          resultCores(cfg.numCPUs) {
+        // Shards are stepped externally; the real-time only options stay off
+        config.autoscale = false;
+    }
+
+    ~ShardedSim() {
+        releaseSegment();
+    }
+
+    bool isValid() const {
+        return shards >= 1 && shards <= MAX_SHARDS && cycles >= 1 && processCount >= 0;
+    }
+
+    // Run with one OS process per shard over a shared-memory segment.
+    // Falls back to runInline() where fork/mmap are unavailable.
+    bool runForked() {
+#ifdef _WIN32
+        std::cout << "Multi-process shards need fork(); running inline instead.\n";
+        return runInline();
+#else
+        if (!createSegment(true)) return false;
+        
+        std::vector<pid_t> children;
+        for (int i = 0; i < shards; i++) {
+            pid_t pid = fork();
+            if (pid < 0) {
+                std::cerr << "ERROR: fork failed for shard " << i << "\n";
+                for (auto c : children) kill(c, SIGKILL);
+                for (auto c : children) waitpid(c, nullptr, 0);
+                return false;
+            }
+            if (pid == 0) {
+                _exit(runShard(i, true) ? 0 : 1);
+            }
+            children.push_back(pid);
+        }
+        
+        // Reap shards as they exit. Peers of a shard that died would wait on
+        // its progress forever, so the first failure aborts the whole run.
+        bool ok = true;
+        int remaining = shards;
+        while (remaining > 0) {
+            bool reaped = false;
+            for (int i = 0; i < shards; i++) {
+                if (children[i] < 0) continue;
+                int status = 0;
+                pid_t pid = waitpid(children[i], &status, WNOHANG);
+                if (pid == 0 || (pid < 0 && errno == EINTR)) continue;
+                children[i] = -1;
+                remaining--;
+                reaped = true;
+                if (pid > 0 && WIFEXITED(status) && WEXITSTATUS(status) == 0) continue;
+                if (ok && !segment->aborted.load()) {
+                    std::cerr << "ERROR: Shard " << i << " died";
+                    if (pid > 0 && WIFSIGNALED(status)) std::cerr << " (signal " << WTERMSIG(status) << ")";
+                    else if (pid > 0 && WIFEXITED(status)) std::cerr << " (exit code " << WEXITSTATUS(status) << ")";
+                    std::cerr << "; stopping the other shards\n";
+                }
+                ok = false;
+                segment->aborted.store(1, std::memory_order_relaxed);
+            }
+            if (!reaped) std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+        resultShards = shards;
+        resultCores = config.numCPUs;
+        return ok && !overflowed();
+#endif
+    }
+
+    // Run every shard in this process, cycle by cycle, through the same rings
+    bool runInline() {
+        if (!createSegment(false)) return false;
+        
+        std::vector<ShardState*> states;
+        for (int i = 0; i < shards; i++) {
+            states.push_back(new ShardState(this, i));
+        }
+        for (int t = 1; t <= cycles; t++) {
+            for (auto s : states) s->step(t);
+        }
+        for (auto s : states) {
+            s->finish();
+            delete s;
+        }
+        resultShards = shards;
+        resultCores = config.numCPUs;
+        return !overflowed();
+    }
+
+    // Baseline: the same arrivals, landing at the same cycles, on one plain
+    // Scheduler with every shard's cores and no migration
+    bool runSingle() {
+        if (!createSegment(false)) return false;
+        
+        SystemConfig combined = config;
+        combined.numCPUs = config.numCPUs * shards;
+        Scheduler node(combined, nullptr);
+        ShardResult result = ShardResult();
+        int freq = std::max(1, config.batchProcessFreq);
+        for (int t = 1; t <= cycles; t++) {
+            int sent = t - lookahead;
+            if (sent >= 1 && sent % freq == 0 && sent / freq <= processCount) {
+                node.addProcess(rebuildProcess({sent / freq - 1, 0, 0, t, 0}));
+                result.arrivals++;
+            }
+            node.stepCycle();
+        }
+        collectFinished(node, result);
+        segment->results[0] = result;
+        resultShards = 1;
+        resultCores = node.getCoreCount();
+        return true;
+    }
+
+    ShardResult getResult(int shard) const { return segment->results[shard]; }
+
+    // Print per-shard results and the combined checksum
+    void displayResults(std::ostream& out, const std::string& mode) const {
+        out << "\n========== SHARDED RUN (" << mode << ") ==========\n";
+        out << "Shards: " << resultShards << " x " << resultCores << " cores | Cycles: " << cycles
+            << " | Processes: " << processCount << " | Seed: " << seed
+            << " | Lookahead: " << lookahead << "\n\n";
+        
+        int finished = 0;
+        unsigned long long checksum = 0;
+        for (int i = 0; i < resultShards; i++) {
+            const ShardResult& r = segment->results[i];
+            out << "Shard " << i << ": arrivals " << r.arrivals << " | finished " << r.finished
+                << " | migrated in " << r.migratedIn << " | migrated out " << r.migratedOut << "\n";
+            finished += r.finished;
+            checksum += r.checksum;
+        }
+        out << "\nTotal finished: " << finished << "\n";
+        out << "Checksum: " << std::hex << checksum << std::dec << "\n";
+        out << "==========================================\n\n";
+    }
+
+private:
+    // One shard: a Scheduler plus its view of the rings
+    struct ShardState {
+        ShardedSim* sim;
+        int index;
+        Scheduler node;
+        ShardResult result;
+
+        ShardState(ShardedSim* owner, int shardIndex)
+            : sim(owner), index(shardIndex), node(owner->config, nullptr), result() {}
+
+        void step(int t) {
+            // Shard 0 routes the processes arriving this cycle
+            if (index == 0) {
+                int freq = std::max(1, sim->config.batchProcessFreq);
+                if (t % freq == 0 && t / freq <= sim->processCount) {
+                    int k = t / freq - 1;
+                    sim->send(0, k % sim->shards, {k, 0, 0, t + sim->lookahead, 0});
+                }
+            }
+            
+            // Take everything due this cycle, sources in fixed order
+            for (int src = 0; src < sim->shards; src++) {
+                Ring& ring = sim->ringFor(src, index);
+                const Message* m;
+                while ((m = ring.peek()) != nullptr && m->deliverCycle <= t) {
+                    Process* p = sim->rebuildProcess(*m);
+                    if (m->migrated) result.migratedIn++;
+                    else result.arrivals++;
+                    ring.pop();
+                    node.addProcess(p);
+                }
+            }
+            
+            node.stepCycle();
+            
+            // Offload one ready process to the next shard when over threshold
+            if (sim->shards > 1 && sim->config.migrationThreshold > 0 && t % sim->lookahead == 0 &&
+                node.getReadyQueueSize() > sim->config.migrationThreshold) {
+                Process* p = node.takeMigrationCandidate();
+                if (p) {
+                    Message m = {p->getID(), p->getInstructionsExecuted(), p->getRegisterA(), t + sim->lookahead, 1};
+                    sim->send(index, (index + 1) % sim->shards, m);
+                    result.migratedOut++;
+                    delete p;
+                }
+            }
+            
+            sim->segment->progress[index].store(t, std::memory_order_release);
+        }
+
+        void finish() {
+            collectFinished(node, result);
+            sim->segment->results[index] = result;
+        }
+    };
+
+    Ring& ringFor(int src, int dst) {
+        return rings[src * shards + dst];
+    }
+
+    // Rings are sized so this cannot fail; if it does, fail the run rather
+    // than wait on a destination that may itself be waiting on this shard
+    void send(int src, int dst, const Message& m) {
+        if (!ringFor(src, dst).push(m)) {
+            segment->overflowed.store(1, std::memory_order_relaxed);
+        }
+    }
+
+    bool overflowed() const {
+        return segment->overflowed.load(std::memory_order_relaxed) != 0;
+    }
+
+    // Most messages a ring can hold at once. A source runs at most 'lookahead'
+    // cycles ahead of its destination, which takes a message 'lookahead'
+    // cycles after it was sent, so a ring holds at most 2 * lookahead cycles
+    // of sends: one arrival per destination every shards * freq cycles, and
+    // at most one migration every lookahead cycles.
+    size_t ringCapacity() const {
+        long long window = 2LL * lookahead;
+        long long freq = std::max(1, config.batchProcessFreq);
+        long long arrivals = std::min<long long>(window / (freq * shards) + 1, processCount);
+        long long needed = arrivals + window / lookahead + 1;
+        size_t capacity = 16;
+        while ((long long)capacity < needed) capacity *= 2;
+        return capacity;
+    }
+
+    // Rebuild a process from its index: same program on every shard and run
+    Process* rebuildProcess(const Message& m) {
+        std::mt19937 rng(seed + (unsigned int)m.processIndex * 2654435761u);
+        std::uniform_int_distribution<int> instructionDist(config.minInstructions, config.maxInstructions);
+        std::uniform_int_distribution<int> addDist(1, 10);
+        
+        int instructions = instructionDist(rng);
+        Process* p = new Process("Process_" + std::to_string(m.processIndex), m.processIndex, instructions, "Shard");
+        p->generateInstructions(instructions, [&]() { return addDist(rng); });
+        p->restoreProgress(m.executed, m.valueOfX);
+        return p;
+    }
+
+    static void collectFinished(const Scheduler& node, ShardResult& result) {
+        result.finished = 0;
+        result.checksum = 0;
+        for (auto p : node.getFinishedProcesses()) {
+            result.finished++;
+            result.checksum += hashFinished(p);
+        }
+    }
+
+    static unsigned long long hashFinished(const Process* p) {
+        unsigned long long h = 1469598103934665603ULL;   // FNV-1a
+        long long fields[3] = {p->getID(), p->getFinishCycle(), p->getRegisterA()};
+        for (long long f : fields) {
+            h ^= (unsigned long long)f;
+            h *= 1099511628211ULL;
+        }
+        return h;
+    }
+
+    // Body of a forked shard: wait for the lookahead window, then step.
+    // Returns false if the run was aborted because another shard died.
+    bool runShard(int index, bool waitForPeers) {
+        ShardState state(this, index);
+        for (int t = 1; t <= cycles; t++) {
+            if (waitForPeers) {
+                for (int s = 0; s < shards; s++) {
+                    if (s == index) continue;
+                    while (segment->progress[s].load(std::memory_order_acquire) < t - lookahead) {
+                        if (segment->aborted.load(std::memory_order_relaxed)) return false;
+                        std::this_thread::yield();
+                    }
+                }
+            }
+            state.step(t);
+        }
+        state.finish();
+        return true;
+    }
+
+    bool createSegment(bool shared) {
+        releaseSegment();
+        size_t ringCount = (size_t)shards * shards;
+        size_t capacity = ringCapacity();
+        segmentBytes = sizeof(Segment) + sizeof(Ring) * ringCount + sizeof(Message) * capacity * ringCount;
+        
+        void* memory = nullptr;
+#ifndef _WIN32
+        if (shared) {
+            memory = mmap(nullptr, segmentBytes, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+            if (memory == MAP_FAILED) {
+                std::cerr << "ERROR: Could not map shared segment\n";
+                return false;
+            }
+        }
+#endif
+        if (!memory) {
+            shared = false;
+            memory = ::operator new(segmentBytes, std::align_val_t(64));
+        }
+        segmentShared = shared;
+        
+        segment = new (memory) Segment();
+        for (int i = 0; i < MAX_SHARDS; i++) {
+            segment->progress[i].store(0);
+            segment->results[i] = ShardResult();
+        }
+        segment->overflowed.store(0);
+        segment->aborted.store(0);
+        rings = reinterpret_cast<Ring*>(static_cast<char*>(memory) + sizeof(Segment));
+        Message* slots = reinterpret_cast<Message*>(rings + ringCount);
+        for (size_t i = 0; i < ringCount; i++) {
+            Ring* r = new (&rings[i]) Ring();
+            r->slots = slots + i * capacity;
+            r->capacity = capacity;
+            r->head.store(0);
+            r->tail.store(0);
+        }
+        return true;
+    }
+
+    void releaseSegment() {
+        if (!segment) return;
+#ifndef _WIN32
+        if (segmentShared) {
+            munmap(segment, segmentBytes);
+            segment = nullptr;
+            rings = nullptr;
+            return;
+        }
+#endif
+        ::operator delete(segment, std::align_val_t(64));
+        segment = nullptr;
+        rings = nullptr;
+    }
+};
+
+#endif // SHARDED_SIM_H
@@ -0,0 +1,309 @@
+#ifndef SLABALLOCATOR_H
+#define SLABALLOCATOR_H
+
+#include <cstdint>
+#include <cstddef>
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include <mutex>
+#include <iostream>
+#include <algorithm>
+
+// Index of the lowest set bit (word must be non-zero)
+inline int findFirstSet(uint64_t word) {
+    return __builtin_ctzll(word);
+}
+
+// FreeBitmap - Three-level bitmap of free slots. A set bit in 'top' marks a
+// non-empty 'middle' word, which marks non-empty 'words'; finding a free slot
+// is three find-first-set operations regardless of how many slots exist.
+// Each word is one slab of up to 64 slots.
+class FreeBitmap {
+private:
+    std::vector<uint64_t> words;    // Bit set = slot free
+    std::vector<uint64_t> middle;   // Bit set = words[i] has a free slot
+    uint64_t top;                   // Bit set = middle[i] is non-zero
+    std::vector<uint8_t> slabSlots; // Slots carved in each word (0 = word unused)
+    std::vector<int> spareWords;    // Words of retired slabs, reused first
+
+    static uint64_t maskOf(int count) {
+        return count >= 64 ? ~0ULL : (1ULL << count) - 1;
+    }
+
+    void markNonEmpty(int w) {
+        middle[w / 64] |= 1ULL << (w % 64);
+        top |= 1ULL << (w / 64);
+    }
+
+    void markEmpty(int w) {
+        middle[w / 64] &= ~(1ULL << (w % 64));
+        if (middle[w / 64] == 0) top &= ~(1ULL << (w / 64));
+    }
+
+public:
+    static const int MAX_SLOTS = 64 * 64 * 64;
+
+    FreeBitmap() : top(0) {}
+
+    // Add a slab whose 'count' (1-64) slots are all free; returns its first
+    // slot, or -1 once MAX_SLOTS is reached
+    int grow(int count) {
+        int w;
+        if (!spareWords.empty()) {
+            w = spareWords.back();
+            spareWords.pop_back();
+        } else {
+            if ((int)words.size() * 64 >= MAX_SLOTS) return -1;
+            w = (int)words.size();
+            words.push_back(0);
+            slabSlots.push_back(0);
+            if (middle.size() * 64 < words.size()) middle.push_back(0);
+        }
+        words[w] = maskOf(count);
+        slabSlots[w] = (uint8_t)count;
+        markNonEmpty(w);
+        return w * 64;
+    }
+
+    // Lowest free slot, or -1 if full
+    int findFree() const {
+        if (top == 0) return -1;
+        int m = findFirstSet(top);
+        int w = m * 64 + findFirstSet(middle[m]);
+        return w * 64 + findFirstSet(words[w]);
+    }
+
+    void take(int slot) {
+        int w = slot / 64;
+        words[w] &= ~(1ULL << (slot % 64));
+        if (words[w] == 0) markEmpty(w);
+    }
+
+    // Free a slot. If that empties its slab, the slab is retired and the
+    // number of slots it had is returned so the caller can reclaim them.
+    int release(int slot) {
+        int w = slot / 64;
+        words[w] |= 1ULL << (slot % 64);
+        if (words[w] != maskOf(slabSlots[w])) {
+            markNonEmpty(w);
+            return 0;
+        }
+        int count = slabSlots[w];
+        words[w] = 0;
+        slabSlots[w] = 0;
+        markEmpty(w);
+        spareWords.push_back(w);
+        return count;
+    }
+};
+
+// SlabClassStats - Occupancy of one size class
+struct SlabClassStats {
+    size_t slotSize;
+    int slots;                  // Slots carved so far
+    int used;
+    int peakUsed;
+    long long allocations;
+    long long failures;
+    long long wastedBytes;      // Slot bytes beyond the requested sizes of live allocations
+
+    float getOccupancy() const {
+        return slots > 0 ? (float)used / slots * 100.0f : 0.0f;
+    }
+};
+
+/**
+ * SlabAllocator - Size-class memory backend for discrete process sizes
+ *
+ * Same allocate/deallocate-by-PID interface as MemoryManager. A request is
+ * served from the smallest class that fits; classes carve slabs of up to 64
+ * slots out of the shared capacity on demand and give a slab back once it is
+ * empty. Allocation and free are O(1).
+ */
+class SlabAllocator {
+private:
+    struct SizeClass {
+        SlabClassStats stats;
+        FreeBitmap freeSlots;
+    };
+
+    struct Allocation {
+        int sizeClass;
+        int slot;
+        size_t size;
+    };
+
+    std::vector<SizeClass> classes;             // Ascending slot size
+    std::unordered_map<int, Allocation> byPID;
+    size_t capacity;
+    size_t carved;                              // Bytes handed to slabs
+    size_t used;                                // Requested bytes of live allocations
+    mutable std::mutex mutex;
+
+    // Smallest class that fits, or classes.size() (there are only a few)
+    int classFor(size_t size) const {
+        int c = 0;
+        while (c < (int)classes.size() && classes[c].stats.slotSize < size) c++;
+        return c;
+    }
+
+    // Take a free slot in the class for 'size', carving a slab if needed (caller holds mutex)
+    bool takeSlot(size_t size, Allocation& allocation) {
+        int c = classFor(size);
+        if (c == (int)classes.size()) return false;
+
+        SizeClass& sizeClass = classes[c];
+        int slot = sizeClass.freeSlots.findFree();
+        if (slot < 0) {
+            // Carve a new slab from the capacity left, no bigger than a quarter
+            // of this class's fair share so one class cannot starve the others
+            size_t slotSize = sizeClass.stats.slotSize;
+            size_t share = std::max<size_t>(1, capacity / (classes.size() * 4 * slotSize));
+            int count = (int)std::min<size_t>(std::min<size_t>(64, share), (capacity - carved) / slotSize);
+            if (count == 0 || (slot = sizeClass.freeSlots.grow(count)) < 0) {
+                sizeClass.stats.failures++;
+                return false;
+            }
+            carved += count * slotSize;
+            sizeClass.stats.slots += count;
+        }
+
+        sizeClass.freeSlots.take(slot);
+        sizeClass.stats.used++;
+        sizeClass.stats.peakUsed = std::max(sizeClass.stats.peakUsed, sizeClass.stats.used);
+        sizeClass.stats.allocations++;
+        sizeClass.stats.wastedBytes += (long long)(sizeClass.stats.slotSize - size);
+        used += size;
+        allocation = {c, slot, size};
+        return true;
+    }
+
+    // Free a slot, giving its slab back if that empties it (caller holds mutex)
+    void releaseSlot(const Allocation& allocation) {
+        SizeClass& sizeClass = classes[allocation.sizeClass];
+        int retired = sizeClass.freeSlots.release(allocation.slot);
+        carved -= retired * sizeClass.stats.slotSize;
+        sizeClass.stats.slots -= retired;
+        sizeClass.stats.used--;
+        sizeClass.stats.wastedBytes -= (long long)(sizeClass.stats.slotSize - allocation.size);
+        used -= allocation.size;
+    }
+
+public:
+    SlabAllocator(std::vector<size_t> classSizes, size_t totalCapacity)
+        : capacity(totalCapacity), carved(0), used(0) {
+        std::sort(classSizes.begin(), classSizes.end());
+        classSizes.erase(std::unique(classSizes.begin(), classSizes.end()), classSizes.end());
+        for (size_t size : classSizes) {
+            SizeClass sizeClass;
+            sizeClass.stats = {size, 0, 0, 0, 0, 0, 0};
+            classes.push_back(sizeClass);
+        }
+    }
+
+    bool allocateMemory(int pid, const std::string& /*processName*/, size_t size) {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (byPID.count(pid)) return false;
+
+        Allocation allocation;
+        if (!takeSlot(size, allocation)) return false;
+        byPID[pid] = allocation;
+        return true;
+    }
+
+    void deallocateMemory(int pid) {
+        std::lock_guard<std::mutex> lock(mutex);
+        auto it = byPID.find(pid);
+        if (it == byPID.end()) return;
+        releaseSlot(it->second);
+        byPID.erase(it);
+    }
+
+    // Change a live allocation's size, moving it to another class if needed.
+    // The old slot is kept if the new one cannot be had.
+    bool resizeMemory(int pid, size_t newSize) {
+        std::lock_guard<std::mutex> lock(mutex);
+        auto it = byPID.find(pid);
+        if (it == byPID.end()) return false;
+
+        Allocation& current = it->second;
+        SlabClassStats& stats = classes[current.sizeClass].stats;
+        if (newSize <= stats.slotSize && classFor(newSize) == current.sizeClass) {
+            stats.wastedBytes += (long long)current.size - (long long)newSize;
+            used = used - current.size + newSize;
+            current.size = newSize;
+            return true;
+        }
+
+        Allocation moved;
+        if (!takeSlot(newSize, moved)) return false;
+        releaseSlot(current);
+        current = moved;
+        return true;
+    }
+
+    // Slot size a request of 'size' is served from; the largest class if
+    // none fits (0 if there are no classes)
+    size_t slotSizeFor(size_t size) const {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (classes.empty()) return 0;
+        int c = classFor(size);
+        return classes[std::min(c, (int)classes.size() - 1)].stats.slotSize;
+    }
+
+    size_t getCapacity() const { return capacity; }
+    size_t getCarvedMemory() const {
+        std::lock_guard<std::mutex> lock(mutex);
+        return carved;
+    }
+    size_t getUsedMemory() const {
+        std::lock_guard<std::mutex> lock(mutex);
+        return used;
+    }
+
+    // Bytes of occupied slots (requested bytes plus internal waste)
+    size_t getOccupiedMemory() const {
+        std::lock_guard<std::mutex> lock(mutex);
+        size_t occupied = 0;
+        for (const auto& sizeClass : classes) {
+            occupied += sizeClass.stats.used * sizeClass.stats.slotSize;
+        }
+        return occupied;
+    }
+
+    // Largest request that would succeed now: a free slot of some class,
+    // or uncarved capacity
+    size_t getLargestFreeBlock() const {
+        std::lock_guard<std::mutex> lock(mutex);
+        size_t largest = capacity - carved;
+        for (const auto& sizeClass : classes) {
+            if (sizeClass.freeSlots.findFree() >= 0) {
+                largest = std::max(largest, sizeClass.stats.slotSize);
+            }
+        }
+        return largest;
+    }
+
+    std::vector<SlabClassStats> getClassStats() const {
+        std::lock_guard<std::mutex> lock(mutex);
+        std::vector<SlabClassStats> stats;
+        for (const auto& sizeClass : classes) {
+            stats.push_back(sizeClass.stats);
+        }
+        return stats;
+    }
+
+    void display(std::ostream& out) const {
+        out << "Slab allocator: " << getUsedMemory() << " B used, " << getCarvedMemory()
+            << " B in slabs, " << capacity << " B capacity\n";
+        for (const auto& stats : getClassStats()) {
+            out << "  " << stats.slotSize << " B: " << stats.used << "/" << stats.slots << " slots ("
+                << stats.getOccupancy() << "%), peak " << stats.peakUsed << ", "
+                << stats.allocations << " allocations, " << stats.failures << " failures, "
+                << stats.wastedBytes << " B internal waste\n";
+        }
+    }
+};
+
+#endif // SLABALLOCATOR_H
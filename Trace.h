@@ -0,0 +1,39 @@
+#ifndef TRACE_H
+#define TRACE_H
+
+// Static tracepoints (USDT) at scheduler hot points
+//
+// When <sys/sdt.h> is available (systemtap-sdt-dev on Linux), every probe is
+// a single NOP plus an ELF note until a tracer attaches, e.g.
+//   bpftrace -e 'usdt:./csopesy:csopesy:dispatch { printf("%d on %d @%d\n", arg0, arg1, arg2); }'
+//   perf probe -x ./csopesy sdt_csopesy:finish
+// Elsewhere (Windows, macOS without DTrace headers) the probes compile away.
+// Build with -DCSOPESY_NO_TRACE to drop them explicitly.
+//
+// Probes (provider "csopesy"), arguments (pid, core, cycle[, bytes]):
+//   arrive        process entered the ready queue (core = -1)
+//   dispatch      process placed on a core
+//   preempt       process taken off a core and requeued
+//   finish        process completed
+//   mem_alloc     process memory allocated (bytes = size)
+//   mem_free      process memory released (bytes = size)
+//   log_flush     instruction log entry written
+
+#if !defined(CSOPESY_NO_TRACE) && defined(__has_include)
+#if __has_include(<sys/sdt.h>)
+#include <sys/sdt.h>
+#define CSOPESY_HAVE_USDT 1
+#endif
+#endif
+
+#ifdef CSOPESY_HAVE_USDT
+#define TRACE_PROBE3(name, pid, core, cycle) \
+    DTRACE_PROBE3(csopesy, name, pid, core, cycle)
+#define TRACE_PROBE4(name, pid, core, cycle, bytes) \
+    DTRACE_PROBE4(csopesy, name, pid, core, cycle, bytes)
+#else
+#define TRACE_PROBE3(name, pid, core, cycle) ((void)0)
+#define TRACE_PROBE4(name, pid, core, cycle, bytes) ((void)0)
+#endif
+
+#endif // TRACE_H
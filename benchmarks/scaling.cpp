@@ -0,0 +1,162 @@
+// Host-thread scaling benchmark
+//
+// Runs a fixed workload (processesPerCore * cores generated processes of a
+// fixed length) through a Cluster of real Schedulers for each simulated core
+// count and host thread count, as fast as the host allows (no cycle pacing).
+// Each host thread drives one node, so the cores are split evenly across
+// nodes. A Scheduler holds at most 128 cores; core counts above 128 * threads
+// use more nodes (and threads) than requested, marked '*' in the table.
+//
+// Build from the repository root:
+//   g++ -std=c++17 -O2 -pthread -I. benchmarks/scaling.cpp -o scaling
+// Run:
+//   ./scaling [max-cores=4096] [instructions-per-process=100] [max-threads=nproc]
+//
+// Columns:
+//   Instr/s     simulated instructions per wall second
+//   us/cycle    wall time per simulated cluster cycle
+//   Wait p99    worst node's recent ready-queue wait (dispatch latency), in cycles
+//   Lock %      host thread time blocked on contended scheduler locks
+//               (coreMutex/queueMutex in the cycle, dispatch and arrival paths)
+//   Barrier %   host thread time blocked at the epoch barrier (load imbalance);
+//               Serial % is the epoch function alone
+//   Eff %       instr/s over the single-thread rate scaled by the thread count
+
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <string>
+#include <random>
+#include <thread>
+#include <chrono>
+#include <algorithm>
+#include <cstdlib>
+#include "Cluster.h"
+
+struct ScalingResult {
+    int cores;
+    int threads;            // Requested
+    int nodes;              // Actually used (one host thread each)
+    double seconds;
+    long long instructions;
+    int cycles;
+    int waitP99;
+    double lockShare;
+    double barrierShare;
+    double serialShare;
+};
+
+static const int MAX_CORES_PER_NODE = 128;
+static const int PROCESSES_PER_CORE = 2;
+
+ScalingResult runWorkload(int cores, int threads, int instructionsPerProcess) {
+    int nodes = std::max(threads, (cores + MAX_CORES_PER_NODE - 1) / MAX_CORES_PER_NODE);
+    int processes = cores * PROCESSES_PER_CORE;
+
+    SystemConfig config;
+    config.numCPUs = cores / nodes;
+    config.schedulerType = "rr";
+    config.quantumCycles = 5;
+    config.minInstructions = instructionsPerProcess;
+    config.maxInstructions = instructionsPerProcess;
+    config.delayPerExec = 0;
+    config.clusterEpochCycles = 10;
+    config.networkDelay = 0;
+    config.migrationThreshold = 0;
+    config.minMemPerProc = 64;
+    config.maxMemPerProc = 64;
+    config.maxOverallMem = 64 * (size_t)processes;
+
+    Cluster cluster(config, nodes, Cluster::ROUND_ROBIN, std::vector<MemoryManager*>(), 0);
+    cluster.setGenerating(false);
+
+    std::mt19937 rng(42);
+    for (int id = 0; id < processes; id++) {
+        cluster.submit(cluster.getNode(0)->createGeneratedProcess(id, rng));
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    cluster.start();
+    while (true) {
+        int finished = 0;
+        for (int i = 0; i < nodes; i++) {
+            finished += cluster.getNode(i)->getFinishedCount();
+        }
+        if (finished >= processes) break;
+        std::this_thread::sleep_for(std::chrono::microseconds(200));
+    }
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    cluster.stop();
+
+    ScalingResult result;
+    result.cores = cores;
+    result.threads = threads;
+    result.nodes = nodes;
+    result.seconds = seconds;
+    result.instructions = (long long)processes * instructionsPerProcess;
+    result.cycles = cluster.getClusterCycle();
+    result.waitP99 = 0;
+    long long lockWaitNanos = 0;
+    for (int i = 0; i < nodes; i++) {
+        result.waitP99 = std::max(result.waitP99, cluster.getNode(i)->getReadyWaitP99());
+        lockWaitNanos += cluster.getNode(i)->getLockWaitNanos();
+    }
+    double threadNanos = seconds * 1e9 * nodes;
+    result.lockShare = lockWaitNanos / threadNanos;
+    result.barrierShare = cluster.getBarrier().getWaitNanos() / threadNanos;
+    result.serialShare = cluster.getBarrier().getEpochNanos() / threadNanos;
+    return result;
+}
+
+int main(int argc, char* argv[]) {
+    int maxCores = argc > 1 ? std::atoi(argv[1]) : 4096;
+    int instructionsPerProcess = argc > 2 ? std::atoi(argv[2]) : 100;
+    int maxThreads = argc > 3 ? std::atoi(argv[3]) : (int)std::thread::hardware_concurrency();
+    if (maxCores < 1 || instructionsPerProcess < 1 || maxThreads < 1) {
+        std::cerr << "Usage: " << argv[0] << " [max-cores] [instructions-per-process] [max-threads]\n";
+        return 1;
+    }
+
+    std::vector<int> coreCounts;
+    for (int cores = 1; cores <= maxCores; cores *= 4) coreCounts.push_back(cores);
+    std::vector<int> threadCounts;
+    for (int threads = 1; threads <= maxThreads; threads *= 2) threadCounts.push_back(threads);
+    if (threadCounts.back() != maxThreads) threadCounts.push_back(maxThreads);
+
+    std::cout << "Scaling benchmark: " << PROCESSES_PER_CORE << " processes per core, "
+              << instructionsPerProcess << " instructions each, up to " << maxThreads << " host threads\n\n";
+    std::cout << " Cores Threads      Instr/s   us/cycle  Wait p99  Lock %  Barrier %  Serial %   Eff %\n";
+
+    for (int cores : coreCounts) {
+        double baseRate = 0;
+        int baseNodes = 0;
+        int lastNodes = 0;
+        for (int threads : threadCounts) {
+            if (threads > cores) break;
+            int nodes = std::max(threads, (cores + MAX_CORES_PER_NODE - 1) / MAX_CORES_PER_NODE);
+            if (cores % nodes != 0 || nodes == lastNodes) continue;
+            lastNodes = nodes;
+
+            ScalingResult r = runWorkload(cores, threads, instructionsPerProcess);
+            double rate = r.instructions / r.seconds;
+            if (baseNodes == 0) {
+                baseRate = rate;
+                baseNodes = r.nodes;
+            }
+            double efficiency = rate / (baseRate * r.nodes / baseNodes) * 100.0;
+
+            std::cout << std::fixed << std::setprecision(1)
+                      << std::setw(6) << r.cores
+                      << std::setw(7) << r.nodes << (r.nodes > r.threads ? "*" : " ")
+                      << std::setw(13) << std::setprecision(0) << rate
+                      << std::setw(11) << std::setprecision(2) << r.seconds * 1e6 / std::max(1, r.cycles)
+                      << std::setw(10) << r.waitP99
+                      << std::setw(8) << std::setprecision(1) << r.lockShare * 100.0
+                      << std::setw(11) << r.barrierShare * 100.0
+                      << std::setw(10) << r.serialShare * 100.0
+                      << std::setw(8) << efficiency << "\n";
+        }
+    }
+    std::cout << "\nEff % is relative to the first row of each core count.\n";
+    return 0;
+}
@@ -0,0 +1,193 @@
+// Concurrency torture test for Scheduler
+//
+// One thread steps cycles as fast as it can (dispatch, preemption, SYSCALL
+// sleeps, heap growth and finish all happen there) while worker threads
+// hammer the public API at the same time:
+//   adders    admitProcess with generated processes
+//   readers   findProcess, getRunningProcesses, getFinishedProcesses and the
+//             size getters
+//   operators suspend/resume/kill random processes and hot-add/remove cores
+// At the end of each epoch the workers meet at a barrier and the last one to
+// arrive runs Scheduler::checkInvariants while the cycle thread keeps going.
+// Exits non-zero if any invariant was violated.
+//
+// Build from the repository root:
+//   g++ -std=c++17 -O2 -pthread -I. benchmarks/torture.cpp -o torture
+// Under ThreadSanitizer (slower; use fewer epochs):
+//   g++ -std=c++17 -O1 -g -fsanitize=thread -pthread -I. benchmarks/torture.cpp -o torture-tsan
+//   ./torture-tsan 5 100
+// Run:
+//   ./torture [epochs=20] [epoch-ms=200] [threads-per-role=2]
+
+#include <iostream>
+#include <vector>
+#include <string>
+#include <random>
+#include <thread>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include "Cluster.h"
+
+struct TortureCounters {
+    std::atomic<long long> admitted{0};
+    std::atomic<long long> rejected{0};
+    std::atomic<long long> lookups{0};
+    std::atomic<long long> snapshots{0};
+    std::atomic<long long> suspends{0};
+    std::atomic<long long> resumes{0};
+    std::atomic<long long> kills{0};
+    std::atomic<long long> hotplugs{0};
+};
+
+int main(int argc, char* argv[]) {
+    int epochs = argc > 1 ? std::atoi(argv[1]) : 20;
+    int epochMs = argc > 2 ? std::atoi(argv[2]) : 200;
+    int threadsPerRole = argc > 3 ? std::atoi(argv[3]) : 2;
+    if (epochs < 1 || epochMs < 1 || threadsPerRole < 1) {
+        std::cerr << "Usage: " << argv[0] << " [epochs] [epoch-ms] [threads-per-role]\n";
+        return 1;
+    }
+
+    SystemConfig config;
+    config.numCPUs = 8;
+    config.schedulerType = "rr";
+    config.quantumCycles = 2;
+    config.minInstructions = 20;
+    config.maxInstructions = 60;
+    config.minMemPerProc = 256;
+    config.maxMemPerProc = 256;
+    config.maxOverallMem = 256 * 4096;
+    config.heapOpsPercent = 10;
+    config.heapMaxAlloc = 128;
+    config.syscallOpsPercent = 10;
+    config.syscallSleepMax = 5;
+    config.syscallIoCycles = 5;
+    config.profileInterval = 7;
+
+    Scheduler scheduler(config, nullptr);
+    TortureCounters counters;
+    std::atomic<int> nextID(0);
+    std::atomic<bool> stopping(false);
+    std::atomic<long long> epochDeadline(0);
+    int epochsDone = 0;
+    int violations = 0;
+
+    auto nowMs = []() {
+        return (long long)std::chrono::duration_cast<std::chrono::milliseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count();
+    };
+
+    int workerCount = threadsPerRole * 3;
+    EpochBarrier barrier(workerCount, [&]() {
+        epochsDone++;
+        for (const auto& violation : scheduler.checkInvariants()) {
+            std::cout << "  epoch " << epochsDone << ": " << violation << "\n";
+            violations++;
+        }
+        if (epochsDone >= epochs) stopping = true;
+        epochDeadline = nowMs() + epochMs;
+    });
+    epochDeadline = nowMs() + epochMs;
+
+    // Name of a process that may or may not still exist
+    auto randomName = [&](std::mt19937& rng) {
+        int count = std::max(1, nextID.load());
+        return "Process_" + std::to_string(std::uniform_int_distribution<int>(0, count - 1)(rng));
+    };
+
+    // Run one role until the epoch ends, then meet the others
+    auto worker = [&](unsigned int seed, auto op) {
+        std::mt19937 rng(seed);
+        while (!stopping) {
+            while (nowMs() < epochDeadline) op(rng);
+            barrier.arriveAndWait();
+        }
+    };
+
+    // Keep the backlog bounded so processes also reach the finish path
+    auto adder = [&](std::mt19937& rng) {
+        if (scheduler.getLoad() >= 4 * config.numCPUs) {
+            std::this_thread::sleep_for(std::chrono::microseconds(100));
+            return;
+        }
+        Process* p = scheduler.createGeneratedProcess(nextID++, rng);
+        if (scheduler.admitProcess(p)) {
+            counters.admitted++;
+        } else {
+            delete p;
+            counters.rejected++;
+        }
+    };
+
+    // Returned pointers are not dereferenced: operators may kill them meanwhile
+    auto reader = [&](std::mt19937& rng) {
+        switch (rng() % 4) {
+            case 0: scheduler.findProcess(randomName(rng)); counters.lookups++; break;
+            case 1: scheduler.getRunningProcesses(); counters.snapshots++; break;
+            case 2: scheduler.getFinishedProcesses(); counters.snapshots++; break;
+            default:
+                scheduler.getReadyQueueSize();
+                scheduler.getLoad();
+                scheduler.getCPUUtilization();
+                counters.snapshots++;
+        }
+    };
+
+    auto op = [&](std::mt19937& rng) {
+        switch (rng() % 8) {
+            case 0: case 1:
+                if (scheduler.suspendProcess(randomName(rng))) counters.suspends++;
+                break;
+            case 2: case 3: case 4:
+                if (scheduler.resumeProcess(randomName(rng))) counters.resumes++;
+                break;
+            case 5:
+                if (scheduler.killProcess(randomName(rng))) counters.kills++;
+                break;
+            case 6:
+                scheduler.addCores(1);
+                counters.hotplugs++;
+                break;
+            default:
+                if (scheduler.getCoreCount() > 2) scheduler.removeCores(1);
+                counters.hotplugs++;
+        }
+        std::this_thread::yield();
+    };
+
+    auto start = std::chrono::steady_clock::now();
+    std::thread cycles([&]() {
+        while (!stopping) scheduler.stepCycle();
+    });
+    std::vector<std::thread> workers;
+    for (int i = 0; i < threadsPerRole; i++) {
+        workers.emplace_back(worker, 100 + i, adder);
+        workers.emplace_back(worker, 200 + i, reader);
+        workers.emplace_back(worker, 300 + i, op);
+    }
+    for (auto& t : workers) t.join();
+    cycles.join();
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    for (const auto& violation : scheduler.checkInvariants()) {
+        std::cout << "  final: " << violation << "\n";
+        violations++;
+    }
+
+    auto perSecond = [&](long long count) { return (long long)(count / seconds); };
+    std::cout << "Torture: " << epochs << " epochs of " << epochMs << " ms, " << workerCount
+              << " worker threads + 1 cycle thread, " << seconds << " s\n";
+    std::cout << "  Cycles:     " << scheduler.getCurrentCycle() << " (" << perSecond(scheduler.getCurrentCycle()) << "/s)\n";
+    std::cout << "  Admitted:   " << counters.admitted << " (" << perSecond(counters.admitted) << "/s), "
+              << counters.rejected << " rejected for memory\n";
+    std::cout << "  Finished:   " << scheduler.getFinishedCount() << " (" << perSecond(scheduler.getFinishedCount()) << "/s)\n";
+    std::cout << "  Reads:      " << counters.lookups << " lookups, " << counters.snapshots << " snapshots ("
+              << perSecond(counters.lookups + counters.snapshots) << "/s)\n";
+    std::cout << "  Operations: " << counters.suspends << " suspends, " << counters.resumes << " resumes, "
+              << counters.kills << " kills, " << counters.hotplugs << " hotplugs\n";
+    std::cout << "  Lock waits: " << scheduler.getLockContentions() << " contended, "
+              << scheduler.getLockWaitNanos() / 1000000 << " ms blocked\n";
+    std::cout << "  Invariants: " << (violations == 0 ? "OK" : std::to_string(violations) + " violations") << "\n";
+    return violations == 0 ? 0 : 1;
+}
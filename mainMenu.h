@@ -8,12 +8,15 @@
 #include "CommandHandler.h"
 #include "Config.h"
 #include "Scheduler.h"
+#include "Cluster.h"
+#include "ShardedSim.h"
 
 class MainMenu {
 private:
     CommandHandler cmdHandler;
     bool clearOnCommand;
     Scheduler* scheduler;
+    Cluster* cluster;
     SystemConfig config;
     
     void displayBanner(){
@@ -48,13 +51,17 @@ private:
                 cmd == "scheduler-start" || 
                 cmd == "scheduler-stop" ||
                 cmd == "report-util" ||
+                cmd == "vmstat" ||
+                cmd == "cluster-stop" ||
+                cmd == "cluster-report" ||
                 cmd == "process-smi");
     }
 
 public:
-    MainMenu() : clearOnCommand(false), scheduler(nullptr) {}
+    MainMenu() : clearOnCommand(false), scheduler(nullptr), cluster(nullptr) {}
     
     ~MainMenu() {
+        delete cluster;
         if (scheduler) {
             scheduler->stop();
             delete scheduler;
@@ -88,12 +95,32 @@ public:
             handleReportUtil();
         });
 
+        // Memory statistics command
+        cmdHandler.registerCommand("vmstat", [this]() {
+            std::cout << "\n";
+            scheduler->writeVmStats(std::cout);
+            std::cout << "\n";
+        });
+
         // Clear screen command
         cmdHandler.registerCommand("clear", [this]() {
             clearScreen();
             displayBanner();
         });
 
+        // Cluster commands (cluster-start takes parameters, see handleSpecialCommands)
+        cmdHandler.registerCommand("cluster-stop", [this]() {
+            handleClusterStop();
+        });
+
+        cmdHandler.registerCommand("cluster-report", [this]() {
+            if (cluster) {
+                cluster->displayReport(std::cout);
+            } else {
+                std::cout << "No cluster running. Use 'cluster-start <nodes> <policy>'.\n\n";
+            }
+        });
+
         // Help command
         cmdHandler.registerCommand("help", [this]() {
             cmdHandler.showHelp();
@@ -191,6 +218,22 @@ private:
         }
     }
 
+    // Append a process's L1 miss rate to a report line (cache model only)
+    void writeCacheMissRate(std::ostream& out, Process* p) {
+        if (p->getCacheAccesses() > 0) {
+            out << "  L1 miss: " << p->getCacheMissRate() << "%";
+        }
+    }
+
+    // Append a process's heap usage and fragmentation (MALLOC/FREE workloads only)
+    void writeHeapStats(std::ostream& out, Process* p) {
+        const ProcessHeap& heap = p->getHeap();
+        if (heap.getAllocations() == 0 && heap.getFailures() == 0) return;
+        out << "  Heap: " << heap.getUsed() << "/" << heap.getCapacity() << " B, frag "
+            << heap.getFragmentation() * 100.0 << "%, " << heap.getGrowths() << " growths, "
+            << heap.getFailures() << " NULL";
+    }
+
     void handleReportUtil() {
         if (scheduler) {
             // Generate filename with timestamp
@@ -213,8 +256,50 @@ private:
             
             // Write CPU utilization
             reportFile << "CPU Utilization: " << scheduler->getCPUUtilization() << "%\n";
-            reportFile << "Cores used: " << scheduler->countActiveCoresPublic() << "/" << config.numCPUs << "\n";
-            reportFile << "Cores available: " << (config.numCPUs - scheduler->countActiveCoresPublic()) << "/" << config.numCPUs << "\n\n";
+            int coreCount = scheduler->getCoreCount();
+            reportFile << "Cores used: " << scheduler->countActiveCoresPublic() << "/" << coreCount << "\n";
+            reportFile << "Cores available: " << (coreCount - scheduler->countActiveCoresPublic()) << "/" << coreCount << "\n";
+            reportFile << "Ready wait p99: " << scheduler->getReadyWaitP99() << " cycles\n\n";
+            
+            // Write per-core statistics (removed cores keep their counters)
+            reportFile << "Per-core utilization:\n";
+            for (const auto& core : scheduler->getCoreStats()) {
+                reportFile << "Core " << core.coreID << ": " << core.getUtilization() << "%  ("
+                           << core.busyCycles << " busy / " << core.idleCycles << " idle cycles)"
+                           << (core.online ? "" : "  [removed]") << "\n";
+                if (core.cacheAccesses > 0) {
+                    reportFile << "        L1 miss: " << (float)core.l1Misses / core.cacheAccesses * 100.0f << "%"
+                               << "  L2 miss: " << (core.l1Misses > 0 ? (float)core.l2Misses / core.l1Misses * 100.0f : 0.0f) << "%"
+                               << "  (" << core.cacheAccesses << " accesses, " << core.stallCycles << " stall cycles)\n";
+                }
+                if (core.systemCycles > 0) {
+                    reportFile << "        User: " << core.userCycles << "  System: " << core.systemCycles << " cycles\n";
+                }
+                if (core.smtStallCycles > 0) {
+                    reportFile << "        SMT stall: " << core.smtStallCycles << " cycles lost to siblings\n";
+                }
+                if (!core.idleResidency.empty()) {
+                    reportFile << "        Idle residency:";
+                    for (size_t i = 0; i < core.idleResidency.size(); i++) {
+                        reportFile << "  C" << (i + 1) << " " << core.idleResidency[i];
+                    }
+                    reportFile << " cycles  Wakeups: " << core.wakeups << " (" << core.wakeupPenaltyCycles
+                               << " penalty cycles)\n";
+                }
+            }
+            reportFile << "\n";
+            
+            // Write per-physical-core statistics (SMT only)
+            auto physicalCores = scheduler->getPhysicalCoreStats();
+            if (!physicalCores.empty()) {
+                reportFile << "Per-physical-core utilization:\n";
+                for (const auto& core : physicalCores) {
+                    reportFile << "Physical " << core.physicalID << ": " << core.getUtilization() << "%  ("
+                               << core.busyCycles << " busy / " << core.idleCycles << " idle cycles, "
+                               << core.getSharedPercent() << "% of busy cycles shared)\n";
+                }
+                reportFile << "\n";
+            }
             
             reportFile << "--------------------------------------\n\n";
             
@@ -227,7 +312,13 @@ private:
                 for (auto p : runningProcs) {
                     reportFile << p->getName() << " (" << p->getArrivalTime() << ")  Core: " 
                                << p->getAssignedCore() << "  " 
-                               << p->getInstructionsExecuted() << "/" << p->getTotalInstructions() << "\n";
+                               << p->getInstructionsExecuted() << "/" << p->getTotalInstructions();
+                    writeCacheMissRate(reportFile, p);
+                    writeHeapStats(reportFile, p);
+                    if (p->getSystemCycles() > 0) {
+                        reportFile << "  User/Sys: " << p->getUserCycles() << "/" << p->getSystemCycles() << " cycles";
+                    }
+                    reportFile << "\n";
                 }
             }
             reportFile << "\n";
@@ -240,11 +331,56 @@ private:
             } else {
                 for (auto p : finishedProcs) {
                     reportFile << p->getName() << " (" << p->getArrivalTime() << ")  Finished  " 
-                               << p->getInstructionsExecuted() << "/" << p->getTotalInstructions() << "\n";
+                               << p->getInstructionsExecuted() << "/" << p->getTotalInstructions();
+                    writeCacheMissRate(reportFile, p);
+                    writeHeapStats(reportFile, p);
+                    if (p->getSystemCycles() > 0) {
+                        reportFile << "  User/Sys: " << p->getUserCycles() << "/" << p->getSystemCycles() << " cycles";
+                    }
+                    reportFile << "\n";
                 }
             }
             reportFile << "\n";
             
+            // Write queueing analytics
+            scheduler->writeQueueingReport(reportFile);
+            reportFile << "\n";
+            
+            // Write system calls and kernel time
+            scheduler->writeSyscallReport(reportFile);
+            
+            // Write process heap activity
+            scheduler->writeHeapReport(reportFile);
+            
+            // Write memory statistics
+            scheduler->writeVmStats(reportFile);
+            reportFile << "\n";
+            
+            // Write slab allocator occupancy
+            if (scheduler->usesSlabAllocator()) {
+                scheduler->writeSlabReport(reportFile);
+                reportFile << "\n";
+            }
+            
+            // Write real-time clock overruns
+            scheduler->writeTickReport(reportFile);
+            reportFile << "\n";
+            
+            // Write DAG runs
+            auto dagRuns = scheduler->getDagRuns();
+            if (!dagRuns.empty()) {
+                int cycle = scheduler->getCurrentCycle();
+                reportFile << "DAG runs:\n";
+                for (const auto& run : dagRuns) {
+                    reportFile << run.source << "  " << run.completedCount << "/" << run.processCount
+                               << "  Makespan: " << run.getMakespan(cycle) << " cycles"
+                               << "  Critical path: " << run.criticalPathCycles << " cycles"
+                               << "  CP utilization: " << run.getCriticalPathUtilization(cycle) << "%"
+                               << (run.finishCycle < 0 ? "  (running)" : "") << "\n";
+                }
+                reportFile << "\n";
+            }
+            
             reportFile << "--------------------------------------\n";
             
             reportFile.close();
@@ -346,6 +482,233 @@ private:
         std::cout << "\n";
     }
 
+    // Create a batch of processes: "--count N --prefix name"
+    void handleBatchCreate(const std::string& args) {
+        std::istringstream iss(args);
+        std::string option;
+        int count = 0;
+        std::string prefix = "batch";
+        
+        while (iss >> option) {
+            if (option == "--count") {
+                iss >> count;
+            } else if (option == "--prefix") {
+                iss >> prefix;
+            } else {
+                count = 0;
+                break;
+            }
+        }
+        
+        if (count <= 0 || prefix.empty()) {
+            std::cout << "Usage: screen -s --count <N> --prefix <name>\n";
+            return;
+        }
+        
+        if (!scheduler) {
+            std::cout << "ERROR: Scheduler not initialized.\n";
+            return;
+        }
+        
+        int created = scheduler->submitProcessBatch(count, prefix);
+        std::cout << "Submitted " << created << " processes with prefix '" << prefix << "'";
+        if (created < count) {
+            std::cout << " (" << count - created << " did not fit in memory)";
+        }
+        std::cout << ".\n\n";
+    }
+
+    // Start a cluster of scheduler nodes, each with config.numCPUs cores
+    void handleClusterStart(const std::string& input) {
+        std::istringstream iss(input);
+        std::string command, policyName = "least-loaded";
+        int nodeCount = 0;
+        iss >> command >> nodeCount >> policyName;
+        
+        Cluster::DispatchPolicy policy;
+        if (nodeCount < 1 || nodeCount > 64 || !Cluster::parsePolicy(policyName, policy)) {
+            std::cout << "Usage: cluster-start <nodes 1-64> <rr|least-loaded|p2c|memory-fit>\n";
+            return;
+        }
+        
+        if (!cmdHandler.isSystemReady()) {
+            std::cout << "ERROR: System not initialized. Please run 'initialize' first.\n\n";
+            return;
+        }
+        
+        if (cluster) {
+            std::cout << "A cluster is already running. Use 'cluster-stop' first.\n\n";
+            return;
+        }
+        
+        cluster = new Cluster(config, nodeCount, policy);
+        cluster->start();
+        std::cout << "Cluster started: " << nodeCount << " nodes x " << config.numCPUs
+                  << " cores, " << Cluster::policyName(policy) << " dispatch.\n\n";
+    }
+
+    void handleClusterStop() {
+        if (!cluster) {
+            std::cout << "No cluster running.\n\n";
+            return;
+        }
+        cluster->stop();
+        cluster->displayReport(std::cout);
+        delete cluster;
+        cluster = nullptr;
+        std::cout << "Cluster stopped.\n\n";
+    }
+
+    // Run a deterministic sharded simulation, one OS process per shard
+    // (or all shards in this process with --inline, or one plain Scheduler
+    // with all their cores with --single, for comparison)
+    void handleShardRun(const std::string& input) {
+        std::istringstream iss(input);
+        std::string command, token;
+        std::vector<long long> numbers;
+        bool runInline = false;
+        bool runSingle = false;
+        
+        iss >> command;
+        while (iss >> token) {
+            if (token == "--inline") {
+                runInline = true;
+            } else if (token == "--single") {
+                runSingle = true;
+            } else {
+                try {
+                    numbers.push_back(std::stoll(token));
+                } catch (...) {
+                    numbers.clear();
+                    break;
+                }
+            }
+        }
+        
+        if (numbers.size() < 3 || numbers.size() > 4) {
+            std::cout << "Usage: shard-run <shards> <cycles> <processes> [seed] [--inline | --single]\n";
+            return;
+        }
+        
+        if (!cmdHandler.isSystemReady()) {
+            std::cout << "ERROR: System not initialized. Please run 'initialize' first.\n\n";
+            return;
+        }
+        
+        unsigned int seed = numbers.size() == 4 ? (unsigned int)numbers[3] : 1;
+        ShardedSim sim(config, (int)numbers[0], (int)numbers[1], (int)numbers[2], seed);
+        if (!sim.isValid()) {
+            std::cout << "ERROR: Need 1-" << ShardedSim::MAX_SHARDS << " shards, at least 1 cycle.\n\n";
+            return;
+        }
+        
+        bool ok = runSingle ? sim.runSingle() : runInline ? sim.runInline() : sim.runForked();
+        if (!ok) {
+            std::cout << "ERROR: Sharded run failed.\n\n";
+            return;
+        }
+        sim.displayResults(std::cout, runSingle ? "single scheduler" : runInline ? "inline" : "multi-process");
+    }
+
+    // Add or remove cores while the simulation runs
+    void handleCoreHotplug(const std::string& input) {
+        std::istringstream iss(input);
+        std::string command;
+        int count = 0;
+        iss >> command >> count;
+        
+        if (count <= 0) {
+            std::cout << "Usage: " << command << " <N>\n";
+            return;
+        }
+        
+        if (!scheduler) {
+            std::cout << "ERROR: Scheduler not initialized.\n";
+            return;
+        }
+        
+        if (command == "cpu-add") {
+            int added = scheduler->addCores(count);
+            std::cout << "Added " << added << " cores";
+        } else {
+            int removed = scheduler->removeCores(count);
+            std::cout << "Removed " << removed << " cores";
+            if (removed < count) {
+                std::cout << "; the rest are needed by queued or running jobs";
+            }
+        }
+        std::cout << " (now " << scheduler->getCoreCount() << ").\n\n";
+    }
+
+    // Submit a batch job with a core count and an estimated instruction count
+    void handleBatchSubmit(const std::string& args) {
+        std::istringstream iss(args);
+        std::string name;
+        int cores = 0, estimate = 0, instructions = 0;
+        
+        if (!(iss >> name >> cores >> estimate)) {
+            std::cout << "Usage: batch-submit <name> <cores> <estimated-instructions> [instructions]\n";
+            return;
+        }
+        if (!(iss >> instructions)) {
+            instructions = estimate;
+        }
+        
+        if (!scheduler) {
+            std::cout << "ERROR: Scheduler not initialized.\n";
+            return;
+        }
+        
+        if (scheduler->submitBatchJob(name, cores, estimate, instructions)) {
+            std::cout << "Batch job '" << name << "' submitted (" << cores << " cores, estimate "
+                      << estimate << " instructions).\n\n";
+        } else {
+            std::cout << "ERROR: Job needs 1-" << scheduler->getCoreCount()
+                      << " cores and positive instruction counts.\n\n";
+        }
+    }
+
+    // Kill, suspend or resume a process by name
+    void handleProcessControl(const std::string& input) {
+        std::istringstream iss(input);
+        std::string command, name;
+        iss >> command >> name;
+        
+        if (name.empty()) {
+            std::cout << "Usage: " << command << " <processname>\n";
+            return;
+        }
+        
+        if (!scheduler) {
+            std::cout << "ERROR: Scheduler not initialized.\n";
+            return;
+        }
+        
+        if (command == "process-kill") {
+            int killed = scheduler->killProcess(name);
+            if (killed > 1) {
+                std::cout << "Process '" << name << "' killed, with " << killed - 1
+                          << " DAG dependent(s) that can no longer start.\n\n";
+            } else if (killed == 1) {
+                std::cout << "Process '" << name << "' killed.\n\n";
+            } else {
+                std::cout << "Process '" << name << "' not found or already finished.\n\n";
+            }
+        } else if (command == "process-suspend") {
+            if (scheduler->suspendProcess(name)) {
+                std::cout << "Process '" << name << "' suspended.\n\n";
+            } else {
+                std::cout << "Process '" << name << "' is not ready or running.\n\n";
+            }
+        } else {
+            if (scheduler->resumeProcess(name)) {
+                std::cout << "Process '" << name << "' resumed.\n\n";
+            } else {
+                std::cout << "Process '" << name << "' is not suspended.\n\n";
+            }
+        }
+    }
+
     // Handle commands with parameters
     bool handleSpecialCommands(const std::string& input) {
         // Handle "screen -r ProcessName" - view specific process
@@ -399,6 +762,75 @@ private:
         }
         
         
+        // Handle "dag-submit file" - load a DAG of dependent processes
+        if (input.find("dag-submit ") == 0) {
+            std::string filename = input.substr(11);
+            if (scheduler) {
+                int count = scheduler->submitDag(filename);
+                if (count > 0) {
+                    std::cout << "Submitted DAG '" << filename << "' with " << count << " processes.\n\n";
+                }
+            } else {
+                std::cout << "ERROR: Scheduler not initialized.\n";
+            }
+            return true;
+        }
+
+        // Handle "profile-dump file" - write sampled stacks for a flame graph
+        if (input.find("profile-dump") == 0) {
+            std::string filename = input.size() > 13 ? input.substr(13) : "";
+            if (!scheduler) {
+                std::cout << "ERROR: Scheduler not initialized.\n";
+            } else if (filename.empty()) {
+                std::cout << "Usage: profile-dump <file>\n";
+            } else if (!scheduler->hasProfiler()) {
+                std::cout << "Profiler is off. Set profile-interval in config.txt.\n";
+            } else {
+                std::cout << "\n";
+                scheduler->dumpProfile(filename, std::cout);
+            }
+            std::cout << "\n";
+            return true;
+        }
+
+        // Handle "cluster-start nodes policy" - run a multi-node cluster
+        if (input.find("cluster-start") == 0) {
+            handleClusterStart(input);
+            return true;
+        }
+
+        // Handle "shard-run shards cycles processes [seed] [--inline | --single]"
+        if (input.find("shard-run") == 0) {
+            handleShardRun(input);
+            return true;
+        }
+
+        // Handle "cpu-add N" / "cpu-remove N" - hotplug cores
+        if (input.find("cpu-add ") == 0 || input.find("cpu-remove ") == 0) {
+            handleCoreHotplug(input);
+            return true;
+        }
+
+        // Handle "batch-submit name cores estimate [instructions]"
+        if (input.find("batch-submit ") == 0) {
+            handleBatchSubmit(input.substr(13));
+            return true;
+        }
+
+        // Handle "process-kill / process-suspend / process-resume ProcessName"
+        if (input.find("process-kill ") == 0 ||
+            input.find("process-suspend ") == 0 ||
+            input.find("process-resume ") == 0) {
+            handleProcessControl(input);
+            return true;
+        }
+
+        // Handle "screen -s --count N --prefix name" - create a batch of processes
+        if (input.find("screen -s --") == 0) {
+            handleBatchCreate(input.substr(10));
+            return true;
+        }
+
         // Handle "screen -s ProcessName" - create process and enter its screen
         if (input.find("screen -s ") == 0) {
             std::string name = input.substr(10);
@@ -419,7 +851,7 @@ private:
                 
                 Process* newProcess = new Process(
                     name,
-                    scheduler->getTotalProcesses(),
+                    scheduler->reserveProcessIDs(1),
                     instructions,
                     "Manual"
                 );